@@ -0,0 +1,110 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_backends.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+#include <time.h>
+
+/*
+** Output backend benchmark: events/s and per-event print latency.
+** Every event is formatted with fmt_line() and handed to sink_write();
+** every TICK events the sink is flushed, as the monitor does once per
+** millisecond. The latency of the flushing call is charged to that
+** event, so p99/max show what batching costs the unlucky philosopher.
+** Results go to stderr; the text itself goes to the backend.
+**
+** Build/run from philo/:
+**   make bench_backends
+**   ./bench_backends <write|writev|io_uring|vmsplice|mmap> [lines] [file]
+** e.g. "./bench_backends writev 1000000 /tmp/out" (file),
+**      "./bench_backends vmsplice 1000000 | cat >/dev/null" (pipe),
+**      "./bench_backends write 100000" in a terminal (tty).
+*/
+
+#define TICK 256
+
+static long	now_ns(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000L + ts.tv_nsec);
+}
+
+static int	cmp_long(const void *a, const void *b)
+{
+	long	x;
+	long	y;
+
+	x = *(const long *)a;
+	y = *(const long *)b;
+	return ((x > y) - (x < y));
+}
+
+/* Formats and writes lines events, recording each call's latency */
+static long	run(t_table *table, long lines, long *lat)
+{
+	char	buf[FMT_LINE_MAX];
+	size_t	len;
+	long	start;
+	long	t0;
+	long	i;
+
+	start = now_ns();
+	i = 0;
+	while (i < lines)
+	{
+		len = fmt_line(buf, 1000 + i / 8, &table->philos[i % 200], i % 4);
+		t0 = now_ns();
+		sink_write(&table->sink, buf, len);
+		if (i % TICK == TICK - 1)
+			sink_flush(&table->sink);
+		lat[i++] = now_ns() - t0;
+	}
+	close_sink(&table->sink);
+	return (now_ns() - start);
+}
+
+int	main(int argc, char **argv)
+{
+	t_table	table;
+	t_philo	philos[200];
+	long	lines;
+	long	*lat;
+	long	total;
+
+	memset(&table, 0, sizeof(table));
+	memset(philos, 0, sizeof(philos));
+	lines = 1000000;
+	if (argc > 2)
+		lines = atol(argv[2]);
+	if (argc > 3)
+		table.opts.out_path = argv[3];
+	if (argc < 2 || lines <= 0 || opt_backend(&table, argv[1]) != 0)
+		return (fprintf(stderr, "usage: %s backend [lines] [file]\n",
+				argv[0]), 1);
+	for (int i = 0; i < 200; i++)
+	{
+		philos[i].id = i + 1;
+		fmt_tag(&philos[i]);
+	}
+	table.philos = philos;
+	lat = malloc(sizeof(long) * lines);
+	if (!lat || open_sink(&table) != 0)
+		return (1);
+	total = run(&table, lines, lat);
+	qsort(lat, lines, sizeof(long), cmp_long);
+	fprintf(stderr, "%-9s %10.0f events/s  p50 %5ld ns  p99 %6ld ns  "
+		"max %8ld ns\n", argv[1], lines * 1e9 / total, lat[lines / 2],
+		lat[lines * 99 / 100], lat[lines - 1]);
+	free(lat);
+	return (0);
+}
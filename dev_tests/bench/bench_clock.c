@@ -0,0 +1,203 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_clock.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** Micro-benchmark: cost of reading the clock, alone and in the hot paths
+** that read it (eat_action, is_philosopher_dead, smart_sleep).
+**   gettimeofday : the old get_time_ms() (wall clock, ms)
+**   monotonic    : get_time_ns() on CLOCK_MONOTONIC (default)
+**   coarse       : get_time_ns() on CLOCK_MONOTONIC_COARSE (--clock coarse)
+**   tsc          : get_time_ns() from the calibrated TSC (--clock tsc)
+** eat_action runs with time_to_eat = 0 and the simulation ended, so it
+** measures the clock + lock + log path without sleeping or printing.
+** smart_sleep(1) reports the mean overshoot past 1ms. Sleeps always
+** poll CLOCK_MONOTONIC (get_mono_ns()), so it should not change with
+** --clock; on COARSE it would be off by up to one tick.
+** The read and is_philosopher_dead columns are then measured again
+** while LOAD_PHILOS philosophers run a real simulation in the same
+** process (output to /dev/null), so the reads compete with the
+** philosophers for the CPU, the vDSO page and meal_lock.
+**
+** Build/run from philo/: make bench_clock && ./bench_clock [reads]
+*/
+
+#define BLUE "\033[0;34m"
+#define RESET "\033[0m"
+#define SLEEP_ROUNDS 200
+#define LOAD_PHILOS "200"
+
+static long	raw_ns(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000L + ts.tv_nsec);
+}
+
+static long	tod_ms(void)
+{
+	struct timeval	tv;
+
+	gettimeofday(&tv, NULL);
+	return ((tv.tv_sec * 1000) + (tv.tv_usec / 1000));
+}
+
+/* 0: clock read, 1: is_philosopher_dead, 2: eat_action */
+static double	bench_path(t_table *table, int path, long reads, long *sink)
+{
+	long	start;
+	long	i;
+
+	start = raw_ns();
+	i = 0;
+	while (i < reads)
+	{
+		if (path == 0)
+			*sink += get_time_ns();
+		else if (path == 1)
+			*sink += is_philosopher_dead(&table->philos[0], get_time_ns());
+		else
+			eat_action(&table->philos[0]);
+		i++;
+	}
+	return ((double)(raw_ns() - start) / reads);
+}
+
+static double	bench_sleep(void)
+{
+	long	start;
+	long	total;
+	int		i;
+
+	total = 0;
+	i = 0;
+	while (i < SLEEP_ROUNDS)
+	{
+		start = raw_ns();
+		smart_sleep(1);
+		total += raw_ns() - start - 1000000;
+		i++;
+	}
+	return ((double)total / SLEEP_ROUNDS / 1000);
+}
+
+/* Selects the clock the way --clock does; tsc falls back when absent */
+static void	select_clock(const char *name)
+{
+	atomic_store(&tsc_state()->active, false);
+	*time_source() = CLOCK_MONOTONIC;
+	if (strcmp(name, "coarse") == 0)
+		*time_source() = CLOCK_MONOTONIC_COARSE;
+	else if (strcmp(name, "tsc") == 0 && tsc_state()->cal_mult)
+		atomic_store(&tsc_state()->active, true);
+}
+
+static double	bench_tod(long reads)
+{
+	long	sink;
+	long	start;
+	long	i;
+
+	sink = 0;
+	start = raw_ns();
+	for (i = 0; i < reads; i++)
+		sink += tod_ms();
+	return ((double)(raw_ns() - start + (sink & 1)) / reads);
+}
+
+static void	bench_clock(t_table *table, const char *name, long reads)
+{
+	long	sink;
+	double	read;
+	double	dead;
+	double	eat;
+
+	select_clock(name);
+	sink = 0;
+	read = bench_path(table, 0, reads, &sink);
+	dead = bench_path(table, 1, reads, &sink);
+	eat = bench_path(table, 2, reads / 10, &sink);
+	printf("%-12s: read %6.2f ns | dead %6.2f ns | eat %7.2f ns"
+		" | sleep(1) +%6.1f us (%ld)\n", name, read, dead, eat,
+		bench_sleep(), sink & 1);
+}
+
+/*
+** @brief: Read costs while a full simulation runs in the process
+** @param: names - clocks to measure, reads - reads per clock
+** @return: 0 on success, 1 if the simulation could not start
+*/
+static int	bench_loaded(const char **names, long reads)
+{
+	static char	*args[] = {"philo", LOAD_PHILOS, "100000", "200", "200",
+		NULL};
+	t_table		table;
+	long		sink;
+	int			i;
+
+	memset(&table, 0, sizeof(table));
+	table.opts.out_path = "/dev/null";
+	if (parse_arguments(&table, 5, args) || init_table(&table)
+		|| open_sink(&table) || create_threads(&table)
+		|| start_monitor(&table))
+		return (1);
+	printf(BLUE "=== Under load (%s philosophers running) ===" RESET "\n",
+		LOAD_PHILOS);
+	printf("%-12s: read %6.2f ns\n", "gettimeofday", bench_tod(reads));
+	sink = 0;
+	i = -1;
+	while (names[++i])
+	{
+		select_clock(names[i]);
+		printf("%-12s: read %6.2f ns | dead %6.2f ns\n", names[i],
+			bench_path(&table, 0, reads, &sink),
+			bench_path(&table, 1, reads, &sink));
+	}
+	select_clock("monotonic");
+	end_simulation(&table);
+	join_monitor(&table);
+	join_threads(&table);
+	cleanup_table(&table);
+	return (sink & 0);
+}
+
+int	main(int argc, char **argv)
+{
+	static char			*args[] = {"philo", "1", "800", "200", "200", NULL};
+	static const char	*names[] = {"monotonic", "coarse", "tsc", NULL};
+	t_table				table;
+	long				reads;
+	int					i;
+
+	reads = 10000000;
+	if (argc > 1)
+		reads = atol(argv[1]);
+	if (reads < 10)
+		return (1);
+	memset(&table, 0, sizeof(table));
+	if (parse_arguments(&table, 5, args) || init_table(&table))
+		return (1);
+	if (!tsc_init())
+		printf("tsc: no invariant TSC, the tsc rows use CLOCK_MONOTONIC\n");
+	table.time_to_eat = 0;
+	table.simulation_end = true;
+	printf(BLUE "=== Clock benchmark (%ld reads) ===" RESET "\n", reads);
+	printf("%-12s: read %6.2f ns\n", "gettimeofday", bench_tod(reads));
+	i = -1;
+	while (names[++i])
+		bench_clock(&table, names[i], reads);
+	select_clock("monotonic");
+	cleanup_table(&table);
+	return (bench_loaded(names, reads / 10));
+}
@@ -0,0 +1,115 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_drift.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** Soak benchmark: cumulative schedule drift of an eat/sleep cycle.
+** One philosopher runs <cycles> eat(ms) + sleep(ms) cycles with no forks
+** and no output, first with smart_sleep() (relative to "now"), then with
+** phase_sleep() (absolute deadlines chained from the previous one). The
+** drift is the time actually spent minus cycles * (eat + sleep), scaled
+** to 10,000 cycles. smart_sleep adds its wake-up overshoot every phase;
+** phase_sleep only ever carries the latency of the last wake-up.
+** phase_sleep runs twice: with --sleep-calib off (margin 0), then after
+** calibrate_sleep(); "late" is the share of phases that ended more
+** than LATE_NS past their deadline.
+**
+** Build/run from philo/: make bench_drift && ./bench_drift [cycles] [ms]
+*/
+
+#define BLUE "\033[0;34m"
+#define RESET "\033[0m"
+#define LATE_NS 50000
+
+static long	g_late;
+
+static void	report(const char *name, long spent, long cycles, long ms)
+{
+	long	drift;
+
+	drift = spent - cycles * 2 * ms * NS_PER_MS;
+	printf("%-18s: %ld cycles in %8.3f s | drift %9.3f ms"
+		" (%8.3f ms / 10k cycles) | late %5.1f %%\n", name, cycles,
+		(double)spent / NS_PER_SEC, (double)drift / NS_PER_MS,
+		(double)drift / NS_PER_MS * 10000 / cycles,
+		100.0 * g_late / (cycles * 2));
+}
+
+static long	run_smart(long cycles, long ms)
+{
+	long	start;
+	long	t;
+	long	i;
+
+	g_late = 0;
+	start = get_mono_ns();
+	i = 0;
+	while (i < cycles * 2)
+	{
+		t = get_mono_ns();
+		smart_sleep(ms);
+		g_late += (get_mono_ns() - t - ms * NS_PER_MS > LATE_NS);
+		i++;
+	}
+	return (get_mono_ns() - start);
+}
+
+static long	run_phase(t_philo *philo, long cycles, long ms)
+{
+	long	start;
+	long	i;
+
+	g_late = 0;
+	philo->deadline = 0;
+	start = get_mono_ns();
+	i = 0;
+	while (i < cycles * 2)
+	{
+		phase_sleep(philo, ms);
+		g_late += (get_mono_ns() - philo->deadline > LATE_NS);
+		i++;
+	}
+	return (get_mono_ns() - start);
+}
+
+int	main(int argc, char **argv)
+{
+	static char	*args[] = {"philo", "1", "800", "200", "200", NULL};
+	t_table		table;
+	long		cycles;
+	long		ms;
+
+	cycles = 10000;
+	ms = 1;
+	if (argc > 1)
+		cycles = atol(argv[1]);
+	if (argc > 2)
+		ms = atol(argv[2]);
+	if (cycles < 1 || ms < 1)
+		return (1);
+	memset(&table, 0, sizeof(table));
+	if (parse_arguments(&table, 5, args) || init_table(&table))
+		return (1);
+	printf(BLUE "=== Drift benchmark (%ld cycles of %ldms + %ldms) ==="
+		RESET "\n", cycles, ms, ms);
+	sleep_calib()->mode = CAL_OFF;
+	report("smart_sleep", run_smart(cycles, ms), cycles, ms);
+	report("phase_sleep", run_phase(&table.philos[0], cycles, ms),
+		cycles, ms);
+	sleep_calib()->mode = CAL_PRINT;
+	calibrate_sleep(1);
+	report("phase_sleep+calib", run_phase(&table.philos[0], cycles, ms),
+		cycles, ms);
+	cleanup_table(&table);
+	return (0);
+}
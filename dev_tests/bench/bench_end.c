@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_end.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** Benchmark: cost of one should_end_simulation() check with T threads
+** checking back to back (what every philosopher loop and every printed
+** line does):
+**   lock   : the previous check, lock sim_lock, read the bool, unlock
+**            (copied here, it is gone from src)
+**   atomic : the real should_end_simulation(), one acquire load of the
+**            padded simulation_end flag
+** Each thread runs for RUN_MS; the cost is CPU time per check, i.e. wall
+** time times the cores the threads could use (min(T, CPUs)) over all
+** checks. Threads beyond the core count only add lock holders preempted
+** inside the critical section.
+**
+** Build/run from philo/: make bench_end && ./bench_end
+*/
+
+#define BLUE "\033[0;34m"
+#define RESET "\033[0m"
+#define RUN_MS 300
+#define MAX_THREADS 512
+
+typedef struct s_bench
+{
+	t_table			table;
+	pthread_mutex_t	sim_lock;
+	bool			old_end;
+	bool			atomic;
+	atomic_int		go;
+	atomic_int		stop;
+	atomic_long		checks;
+	atomic_int		seen;
+}	t_bench;
+
+static int	old_should_end(t_bench *b)
+{
+	int	result;
+
+	pthread_mutex_lock(&b->sim_lock);
+	result = b->old_end;
+	pthread_mutex_unlock(&b->sim_lock);
+	return (result);
+}
+
+static void	*checker(void *arg)
+{
+	t_bench	*b;
+	long	n;
+	int		i;
+	int		seen;
+
+	b = arg;
+	n = 0;
+	seen = 0;
+	while (!atomic_load_explicit(&b->go, memory_order_acquire))
+		sched_yield();
+	while (!atomic_load_explicit(&b->stop, memory_order_relaxed))
+	{
+		i = 0;
+		while (i++ < 64)
+		{
+			if (b->atomic)
+				seen += should_end_simulation(&b->table);
+			else
+				seen += old_should_end(b);
+		}
+		n += 64;
+	}
+	atomic_fetch_add(&b->checks, n);
+	atomic_fetch_add(&b->seen, seen);
+	return (NULL);
+}
+
+static double	run(t_bench *b, int threads)
+{
+	static pthread_t	tid[MAX_THREADS];
+	long				cores;
+	long				start;
+	long				wall;
+	int					i;
+
+	atomic_store(&b->go, 0);
+	atomic_store(&b->stop, 0);
+	atomic_store(&b->checks, 0);
+	i = 0;
+	while (i < threads)
+		pthread_create(&tid[i++], NULL, checker, b);
+	start = get_mono_ns();
+	atomic_store_explicit(&b->go, 1, memory_order_release);
+	usleep(RUN_MS * 1000);
+	atomic_store(&b->stop, 1);
+	wall = get_mono_ns() - start;
+	i = 0;
+	while (i < threads)
+		pthread_join(tid[i++], NULL);
+	cores = sysconf(_SC_NPROCESSORS_ONLN);
+	if (cores > threads)
+		cores = threads;
+	return ((double)wall * cores / atomic_load(&b->checks));
+}
+
+int	main(void)
+{
+	static int		counts[] = {4, 64, 512, 0};
+	static t_bench	b;
+	double			ns[2];
+	int				i;
+
+	pthread_mutex_init(&b.sim_lock, NULL);
+	atomic_init(&b.table.simulation_end, false);
+	printf(BLUE "=== should_end_simulation() cost (%ld CPUs, %d ms per run) ==="
+		RESET "\n", sysconf(_SC_NPROCESSORS_ONLN), RUN_MS);
+	i = 0;
+	while (counts[i])
+	{
+		b.atomic = false;
+		ns[0] = run(&b, counts[i]);
+		b.atomic = true;
+		ns[1] = run(&b, counts[i]);
+		printf("%4d threads | lock %8.2f ns/check | atomic %6.2f ns/check\n",
+			counts[i], ns[0], ns[1]);
+		i++;
+	}
+	pthread_mutex_destroy(&b.sim_lock);
+	return (0);
+}
@@ -0,0 +1,218 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_forklock.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** Benchmark: fork lock kinds (--fork-lock) under the worst contention.
+** N threads sit in a ring and take their two forks lower index first
+** through fork_lock(), exactly like the hierarchy strategy. Each holds
+** them for HOLD_NS, drops them and immediately asks again (no sleep, no
+** think), for RUN_MS. Per kind and N it reports:
+**   pairs/s : fork pairs taken per second, all threads together
+**   handoff : time from the unlock a blocked thread was waiting for to
+**             the moment it holds the fork (p50 / p99), in us
+**   barged  : share of fast-path takes that jumped a neighbor already
+**             blocked on that fork (the releaser taking it back)
+**   max wait: longest single fork wait, in ms (convoys show up here)
+**
+** Build/run from philo/: make bench_forklock && ./bench_forklock
+*/
+
+#define BLUE "\033[0;34m"
+#define RESET "\033[0m"
+#define RUN_MS 1000
+#define HOLD_NS 2000L
+#define SAMPLES 256
+
+typedef struct s_bench
+{
+	t_table			table;
+	atomic_long		*released;
+	atomic_int		*blocked;
+	atomic_int		stop;
+}	t_bench;
+
+typedef struct s_worker
+{
+	t_bench			*b;
+	pthread_t		thread;
+	int				id;
+	long			pairs;
+	long			fast;
+	long			barged;
+	long			max_wait;
+	int				n;
+	long			handoff[SAMPLES];
+}	t_worker;
+
+static int	cmp_long(const void *a, const void *b)
+{
+	return ((*(const long *)a > *(const long *)b)
+		- (*(const long *)a < *(const long *)b));
+}
+
+/* Takes fork k, recording whether it had to wait and for how long */
+static void	take(t_worker *w, int k)
+{
+	t_bench	*b;
+	long	t0;
+	long	t1;
+	long	rel;
+
+	b = w->b;
+	if (fork_trylock(&b->table, k))
+	{
+		w->fast++;
+		w->barged += (atomic_load_explicit(&b->blocked[k],
+					memory_order_relaxed) > 0);
+		return ;
+	}
+	atomic_fetch_add(&b->blocked[k], 1);
+	t0 = get_mono_ns();
+	fork_lock(&b->table, k);
+	t1 = get_mono_ns();
+	atomic_fetch_sub(&b->blocked[k], 1);
+	rel = atomic_load_explicit(&b->released[k], memory_order_relaxed);
+	if (rel < t0)
+		rel = t0;
+	if (w->n < SAMPLES)
+		w->handoff[w->n++] = t1 - rel;
+	if (t1 - t0 > w->max_wait)
+		w->max_wait = t1 - t0;
+}
+
+static void	drop(t_worker *w, int k)
+{
+	atomic_store_explicit(&w->b->released[k], get_mono_ns(),
+		memory_order_relaxed);
+	fork_unlock(&w->b->table, k);
+}
+
+static void	*worker(void *arg)
+{
+	t_worker	*w;
+	int			lo;
+	int			hi;
+	long		until;
+
+	w = arg;
+	lo = w->id;
+	hi = (w->id + 1) % w->b->table.philo_count;
+	if (hi < lo)
+	{
+		hi = lo;
+		lo = 0;
+	}
+	while (!atomic_load_explicit(&w->b->stop, memory_order_relaxed))
+	{
+		take(w, lo);
+		take(w, hi);
+		until = get_mono_ns() + HOLD_NS;
+		while (get_mono_ns() < until)
+			;
+		drop(w, hi);
+		drop(w, lo);
+		w->pairs++;
+	}
+	return (NULL);
+}
+
+static void	report(const char *kind, int n, t_worker *w, long wall)
+{
+	long	*all;
+	long	count;
+	long	sum[4];
+	int		i;
+
+	all = malloc(sizeof(long) * SAMPLES * n);
+	count = 0;
+	memset(sum, 0, sizeof(sum));
+	i = -1;
+	while (++i < n)
+	{
+		memcpy(all + count, w[i].handoff, sizeof(long) * w[i].n);
+		count += w[i].n;
+		sum[0] += w[i].pairs;
+		sum[1] += w[i].fast;
+		sum[2] += w[i].barged;
+		if (w[i].max_wait > sum[3])
+			sum[3] = w[i].max_wait;
+	}
+	qsort(all, count, sizeof(long), cmp_long);
+	printf("  %-6s %10.0f pairs/s  handoff p50 %8.1f p99 %9.1f us  "
+		"barged %5.1f%%  max wait %7.1f ms\n", kind,
+		(double)sum[0] * NS_PER_SEC / wall,
+		count ? all[count / 2] / 1000.0 : 0,
+		count ? all[count * 99 / 100] / 1000.0 : 0,
+		sum[1] ? 100.0 * sum[2] / sum[1] : 0,
+		(double)sum[3] / NS_PER_MS);
+	free(all);
+}
+
+static void	run(const char *kind, int n)
+{
+	t_bench		b;
+	t_worker	*w;
+	long		wall;
+	int			i;
+
+	memset(&b, 0, sizeof(b));
+	b.table.philo_count = n;
+	b.released = calloc(n, sizeof(atomic_long));
+	b.blocked = calloc(n, sizeof(atomic_int));
+	w = calloc(n, sizeof(t_worker));
+	if (!b.released || !b.blocked || !w || init_mutexes(&b.table)
+		|| opt_fork_lock(&b.table, (char *)kind) || init_fork_lock(&b.table))
+		exit(1);
+	wall = get_mono_ns();
+	i = -1;
+	while (++i < n)
+	{
+		w[i].b = &b;
+		w[i].id = i;
+		pthread_create(&w[i].thread, NULL, worker, &w[i]);
+	}
+	usleep(RUN_MS * 1000);
+	atomic_store(&b.stop, 1);
+	while (i-- > 0)
+		pthread_join(w[i].thread, NULL);
+	report(kind, n, w, get_mono_ns() - wall);
+	free_fork_lock(&b.table);
+	while (++i < n)
+		pthread_mutex_destroy(&b.table.forks[i]);
+	free(b.table.forks);
+	pthread_mutex_destroy(&b.table.write_lock);
+	free(b.released);
+	free(b.blocked);
+	free(w);
+}
+
+int	main(void)
+{
+	static int	counts[] = {5, 200, 2000, 0};
+	int			i;
+
+	printf(BLUE "=== Fork locks (%ld CPUs, %d ms per run, %ld ns hold) ==="
+		RESET "\n", sysconf(_SC_NPROCESSORS_ONLN), RUN_MS, HOLD_NS);
+	i = 0;
+	while (counts[i])
+	{
+		printf("N = %d\n", counts[i]);
+		run("mutex", counts[i]);
+		run("futex", counts[i]);
+		run("ticket", counts[i]);
+		fflush(stdout);
+		i++;
+	}
+	return (0);
+}
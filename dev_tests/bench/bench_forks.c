@@ -0,0 +1,165 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_forks.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** Benchmark: fork acquisition strategies (--forks) on the same
+** workloads, with the real philosopher and monitor threads, for RUN_MS
+** each (output to /dev/null). A sampler polls every last_meal_time each
+** millisecond and reports:
+**   meals/s : meals of everyone over the run
+**   fairness: Jain's index over the meal counts (1.0 = all equal)
+**   hunger  : worst gap between two meals of one philosopher (start to
+**             first meal and last meal to end included), in ms
+**   death   : when the monitor ended the run with a death, if it did
+** A meal is at least time_to_eat long, so the 1 ms poll sees each one.
+**
+** Build/run from philo/: make bench_forks && ./bench_forks
+*/
+
+#define BLUE "\033[0;34m"
+#define RESET "\033[0m"
+#define RUN_MS 3000
+#define POLL_NS 1000000L
+
+typedef struct s_result
+{
+	double	meals_per_s;
+	double	fairness;
+	double	hunger_ms;
+	long	death_ms;
+}	t_result;
+
+static void	sample(t_table *table, long *last, long *hunger, long until)
+{
+	long	seen;
+	int		i;
+
+	while (!should_end_simulation(table) && get_time_ns() < until)
+	{
+		abs_sleep(get_mono_ns() + POLL_NS);
+		i = -1;
+		while (++i < table->philo_count)
+		{
+			seen = atomic_load_explicit(&table->philos[i].last_meal_time,
+					memory_order_acquire);
+			if (seen != last[i] && seen - last[i] > *hunger)
+				*hunger = seen - last[i];
+			last[i] = seen;
+		}
+	}
+}
+
+static void	summarize(t_table *table, long *last, long hunger, t_result *r)
+{
+	double	sum;
+	double	sq;
+	long	end;
+	int		meals;
+	int		i;
+
+	end = get_time_ns();
+	sum = 0;
+	sq = 0;
+	i = -1;
+	while (++i < table->philo_count)
+	{
+		meals = atomic_load(&table->philos[i].meals_count);
+		sum += meals;
+		sq += (double)meals * meals;
+		if (end - last[i] > hunger)
+			hunger = end - last[i];
+	}
+	r->meals_per_s = sum * NS_PER_SEC / (end - table->start_time);
+	r->fairness = 0;
+	if (sq > 0)
+		r->fairness = sum * sum / (table->philo_count * sq);
+	r->hunger_ms = (double)hunger / NS_PER_MS;
+}
+
+static int	run_once(char **args, const char *strategy, t_result *r)
+{
+	t_table	table;
+	long	*last;
+	long	hunger;
+	int		i;
+
+	memset(&table, 0, sizeof(table));
+	table.opts.out_path = "/dev/null";
+	if (parse_arguments(&table, 5, args) || opt_forks(&table, (char *)strategy)
+		|| init_table(&table) || open_sink(&table))
+		return (1);
+	last = malloc(sizeof(long) * table.philo_count);
+	i = -1;
+	while (++i < table.philo_count)
+		last[i] = table.start_time;
+	hunger = 0;
+	if (create_threads(&table) || start_monitor(&table))
+		return (1);
+	sample(&table, last, &hunger, table.start_time + RUN_MS * NS_PER_MS);
+	r->death_ms = -1;
+	if (should_end_simulation(&table))
+		r->death_ms = elapsed_ms(table.start_time);
+	end_simulation(&table);
+	monitor_kick(&table);
+	summarize(&table, last, hunger, r);
+	join_monitor(&table);
+	join_threads(&table);
+	free(last);
+	cleanup_table(&table);
+	return (0);
+}
+
+static void	bench(char *count, char *die, char *eat, char *sleep)
+{
+	static const char	*strategies[] = {
+		"hierarchy", "even-odd", "waiter", "chandy-misra", "edf", NULL
+	};
+	char				*args[6];
+	t_result			r;
+	int					s;
+
+	args[0] = "philo";
+	args[1] = count;
+	args[2] = die;
+	args[3] = eat;
+	args[4] = sleep;
+	args[5] = NULL;
+	printf("%s %s %s %s\n", count, die, eat, sleep);
+	s = 0;
+	while (strategies[s])
+	{
+		if (run_once(args, strategies[s], &r) == 0)
+		{
+			printf("  %-13s %8.1f meals/s  fairness %.3f  hunger %7.1f ms",
+				strategies[s], r.meals_per_s, r.fairness, r.hunger_ms);
+			if (r.death_ms >= 0)
+				printf("  died at %ld ms", r.death_ms);
+			printf("\n");
+			fflush(stdout);
+		}
+		s++;
+	}
+}
+
+int	main(void)
+{
+	printf(BLUE "=== Fork strategies (%ld CPUs, %d ms per run) ===" RESET "\n",
+		sysconf(_SC_NPROCESSORS_ONLN), RUN_MS);
+	bench("5", "800", "200", "200");
+	bench("4", "410", "200", "200");
+	bench("5", "610", "200", "200");
+	bench("200", "800", "200", "200");
+	bench("199", "800", "200", "200");
+	return (0);
+}
@@ -0,0 +1,219 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_meal.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** Benchmark: contention on the meal state. E eater threads publish meals
+** back to back (the eat_action() update, without the sleep) while one
+** monitor thread runs the death and must-eat checks over everyone:
+**   lock   : the previous layout, one global meal_lock and the fields
+**            packed next to each other (copied here, it is gone from src)
+**   atomic : per-philosopher atomics on their own cache line, read with
+**            is_philosopher_dead() / all_philosophers_satisfied()
+** Reports meal updates/s (all eaters), monitor scans/s over RUN_MS, and
+** for the lock the share of eater acquisitions that found it held (the
+** atomics have no such wait by construction).
+** On a single CPU the contention shows up as lock holders preempted
+** inside the critical section; with more cores add cache-line traffic.
+**
+** Build/run from philo/: make bench_meal && ./bench_meal
+*/
+
+#define BLUE "\033[0;34m"
+#define RESET "\033[0m"
+#define RUN_MS 300
+
+typedef struct s_old_meal
+{
+	int		meals_count;
+	long	last_meal_time;
+}	t_old_meal;
+
+typedef struct s_bench
+{
+	t_table			table;
+	t_old_meal		*old;
+	pthread_mutex_t	meal_lock;
+	bool			atomic;
+	atomic_int		stop;
+	atomic_long		updates;
+	atomic_long		waits;
+	long			scans;
+	long			seen;
+}	t_bench;
+
+typedef struct s_eater
+{
+	t_bench			*b;
+	int				i;
+}	t_eater;
+
+static void	*eater(void *arg)
+{
+	t_eater	*e;
+	t_philo	*philo;
+	long	n;
+	long	waits;
+
+	e = arg;
+	waits = 0;
+	philo = &e->b->table.philos[e->i];
+	n = 0;
+	while (!atomic_load_explicit(&e->b->stop, memory_order_relaxed))
+	{
+		if (e->b->atomic)
+		{
+			atomic_store_explicit(&philo->last_meal_time, get_time_ns(),
+				memory_order_release);
+			atomic_fetch_add_explicit(&philo->meals_count, 1,
+				memory_order_release);
+		}
+		else
+		{
+			if (pthread_mutex_trylock(&e->b->meal_lock) != 0)
+			{
+				waits++;
+				pthread_mutex_lock(&e->b->meal_lock);
+			}
+			e->b->old[e->i].last_meal_time = get_time_ns();
+			e->b->old[e->i].meals_count++;
+			pthread_mutex_unlock(&e->b->meal_lock);
+		}
+		n++;
+	}
+	atomic_fetch_add(&e->b->updates, n);
+	atomic_fetch_add(&e->b->waits, waits);
+	return (NULL);
+}
+
+/* The previous is_philosopher_dead() loop plus all_philosophers_satisfied() */
+static int	old_scan(t_bench *b, long now)
+{
+	int	dead;
+	int	i;
+
+	dead = 0;
+	i = 0;
+	while (i < b->table.philo_count)
+	{
+		pthread_mutex_lock(&b->meal_lock);
+		dead += (now - b->old[i].last_meal_time
+				>= b->table.time_to_die * NS_PER_MS);
+		pthread_mutex_unlock(&b->meal_lock);
+		i++;
+	}
+	pthread_mutex_lock(&b->meal_lock);
+	i = 0;
+	while (i < b->table.philo_count
+		&& b->old[i].meals_count >= b->table.must_eat_count)
+		i++;
+	pthread_mutex_unlock(&b->meal_lock);
+	return (dead + (i == b->table.philo_count));
+}
+
+static void	*monitor(void *arg)
+{
+	t_bench	*b;
+	long	now;
+	int		i;
+
+	b = arg;
+	while (!atomic_load_explicit(&b->stop, memory_order_relaxed))
+	{
+		now = get_time_ns();
+		if (b->atomic)
+		{
+			i = 0;
+			while (i < b->table.philo_count)
+				b->seen += is_philosopher_dead(&b->table.philos[i++], now);
+			b->seen += all_philosophers_satisfied(&b->table);
+		}
+		else
+			b->seen += old_scan(b, now);
+		b->scans++;
+	}
+	return (NULL);
+}
+
+static void	run(t_bench *b, int eaters, double *rate)
+{
+	pthread_t	threads[256];
+	t_eater		args[256];
+	pthread_t	mon;
+	int			i;
+
+	atomic_store(&b->stop, 0);
+	atomic_store(&b->updates, 0);
+	atomic_store(&b->waits, 0);
+	b->scans = 0;
+	pthread_create(&mon, NULL, monitor, b);
+	i = -1;
+	while (++i < eaters)
+	{
+		args[i].b = b;
+		args[i].i = i;
+		pthread_create(&threads[i], NULL, eater, &args[i]);
+	}
+	usleep(RUN_MS * 1000);
+	atomic_store(&b->stop, 1);
+	i = 0;
+	while (i < eaters)
+		pthread_join(threads[i++], NULL);
+	pthread_join(mon, NULL);
+	rate[0] = atomic_load(&b->updates) * 1000.0 / RUN_MS;
+	rate[1] = b->scans * 1000.0 / RUN_MS;
+	rate[2] = 100.0 * atomic_load(&b->waits) / (atomic_load(&b->updates) + 1);
+}
+
+static void	bench(char *count)
+{
+	char	*args[7];
+	t_bench	b;
+	double	rate[6];
+
+	args[0] = "philo";
+	args[1] = count;
+	args[2] = "800";
+	args[3] = "200";
+	args[4] = "200";
+	args[5] = "1000000";
+	args[6] = NULL;
+	memset(&b, 0, sizeof(b));
+	if (parse_arguments(&b.table, 6, args) || init_table(&b.table))
+		return ;
+	b.old = calloc(b.table.philo_count, sizeof(t_old_meal));
+	pthread_mutex_init(&b.meal_lock, NULL);
+	b.atomic = false;
+	run(&b, b.table.philo_count, rate);
+	b.atomic = true;
+	run(&b, b.table.philo_count, rate + 3);
+	pthread_mutex_destroy(&b.meal_lock);
+	free(b.old);
+	cleanup_table(&b.table);
+	printf("%4s | lock %6.2f M upd/s %8.0f scans/s %5.2f%% waited"
+		" | atomic %6.2f M upd/s %8.0f scans/s\n", count, rate[0] / 1e6,
+		rate[1], rate[2], rate[3] / 1e6, rate[4]);
+}
+
+int	main(void)
+{
+	static char	*counts[] = {"1", "2", "4", "16", "64", "200", NULL};
+	int			i;
+
+	printf(BLUE "=== Meal state contention (%ld CPUs, %d ms per run) ==="
+		RESET "\n", sysconf(_SC_NPROCESSORS_ONLN), RUN_MS);
+	i = 0;
+	while (counts[i])
+		bench(counts[i++]);
+	return (0);
+}
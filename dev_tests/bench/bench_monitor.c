@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_monitor.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** Benchmark: cost of one monitor death check against the philosopher
+** count, with the deadline heap (check_deaths()) and with the previous
+** O(N) scan (is_philosopher_dead() on everyone, one acquire load
+** each). No threads run; the bench plays the philosophers:
+**   idle  : nothing is due, the check at start + 1 ms
+**   churn : TICKS monitor ticks of 1 ms, each philosopher eating once
+**           every time_to_die / 2, spread evenly over the ticks; the
+**           heap re-keys each meal once when its old deadline passes
+** Costs are ns per monitor tick.
+**
+** Build/run from philo/: make bench_monitor && ./bench_monitor
+*/
+
+#define BLUE "\033[0;34m"
+#define RESET "\033[0m"
+#define TICKS 4000
+#define TTD 800
+
+static bool	scan_deaths(t_table *table, long now)
+{
+	int	i;
+
+	i = 0;
+	while (i < table->philo_count)
+		if (is_philosopher_dead(&table->philos[i++], now))
+			return (true);
+	return (false);
+}
+
+static bool	check(t_table *table, long now, bool heap)
+{
+	if (heap)
+		return (check_deaths(&table->monitors[0], now));
+	return (scan_deaths(table, now));
+}
+
+static double	bench_idle(t_table *table, bool heap)
+{
+	long	start;
+	long	now;
+	int		rounds;
+	int		i;
+
+	rounds = 20000000 / table->philo_count + 100;
+	now = table->start_time + NS_PER_MS;
+	start = get_mono_ns();
+	i = 0;
+	while (i++ < rounds)
+		if (check(table, now, heap))
+			return (-1);
+	return ((double)(get_mono_ns() - start) / rounds);
+}
+
+/* Philosophers i with i % (TTD / 2) == tick % (TTD / 2) eat at tick */
+static double	bench_churn(t_table *table, bool heap)
+{
+	long	spent;
+	long	start;
+	long	now;
+	int		tick;
+	int		i;
+
+	spent = 0;
+	tick = 0;
+	while (tick < TICKS)
+	{
+		now = table->start_time + tick * NS_PER_MS;
+		i = tick % (TTD / 2);
+		while (i < table->philo_count)
+		{
+			table->philos[i].last_meal_time = now;
+			i += TTD / 2;
+		}
+		start = get_mono_ns();
+		if (check(table, now, heap))
+			return (-1);
+		spent += get_mono_ns() - start;
+		tick++;
+	}
+	return ((double)spent / TICKS);
+}
+
+static void	run(char *count)
+{
+	char	*args[6];
+	t_table	table;
+	double	cost[4];
+	int		mode;
+
+	args[0] = "philo";
+	args[1] = count;
+	args[2] = "800";
+	args[3] = "200";
+	args[4] = "200";
+	args[5] = NULL;
+	mode = 0;
+	while (mode < 2)
+	{
+		memset(&table, 0, sizeof(table));
+		table.opts.monitors = 1;
+		if (parse_arguments(&table, 5, args) || init_table(&table))
+			return ;
+		cost[mode * 2] = bench_idle(&table, mode == 0);
+		cost[mode * 2 + 1] = bench_churn(&table, mode == 0);
+		cleanup_table(&table);
+		mode++;
+	}
+	printf("%6s | heap idle %8.1f ns  churn %8.1f ns | scan idle %10.1f ns"
+		"  churn %10.1f ns\n", count, cost[0], cost[1], cost[2], cost[3]);
+}
+
+int	main(void)
+{
+	static char	*counts[] = {"5", "50", "500", "5000", "10000", NULL};
+	int			i;
+
+	printf(BLUE "=== Monitor death check (ns per tick) ===" RESET "\n");
+	i = 0;
+	while (counts[i])
+		run(counts[i++]);
+	return (0);
+}
@@ -0,0 +1,148 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_shard.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** Benchmark: death detection latency against N for 1, 2, 4 and 8
+** monitor shards (--monitors), with the real monitor threads. Everyone
+** starts with the same deadline, start + TTD. Halfway there a feeder
+** thread gives every philosopher but one a meal, so at the deadline each
+** shard has to re-key its whole slice (the worst case, and what the first
+** time_to_die of a real run looks like). The victim starts VICTIM_LAG_NS
+** later than the others, so its shard re-keys everyone else first.
+** Latency is from the victim's deadline to the return of the last
+** monitor (median of REPS runs), in ms; output goes to /dev/null.
+** Shards only help with cores to run them on.
+**
+** Build/run from philo/: make bench_shard && ./bench_shard
+*/
+
+#define BLUE "\033[0;34m"
+#define RESET "\033[0m"
+#define REPS 3
+#define VICTIM_LAG_NS 50000L
+
+static void	*feeder(void *arg)
+{
+	t_table	*table;
+	long	now;
+	int		i;
+
+	table = arg;
+	abs_sleep(table->start_time + table->time_to_die * NS_PER_MS / 2);
+	now = get_time_ns();
+	i = 0;
+	while (i < table->philo_count)
+	{
+		if (i != table->philo_count / 2)
+			atomic_store_explicit(&table->philos[i].last_meal_time, now,
+				memory_order_release);
+		i++;
+	}
+	return (NULL);
+}
+
+static double	run_once(char *count, int monitors)
+{
+	char		*args[6];
+	t_table		table;
+	pthread_t	feed;
+	long		deadline;
+	double		latency;
+
+	args[0] = "philo";
+	args[1] = count;
+	args[2] = "200";
+	args[3] = "100";
+	args[4] = "100";
+	args[5] = NULL;
+	memset(&table, 0, sizeof(table));
+	table.opts.monitors = monitors;
+	table.opts.out_path = "/dev/null";
+	if (parse_arguments(&table, 5, args) || init_table(&table)
+		|| open_sink(&table))
+		return (-1);
+	deadline = table.start_time + VICTIM_LAG_NS;
+	atomic_store(&table.philos[table.philo_count / 2].last_meal_time,
+		deadline);
+	free_monitors(&table);
+	if (init_monitors(&table))
+		return (-1);
+	deadline += table.time_to_die * NS_PER_MS;
+	pthread_create(&feed, NULL, feeder, &table);
+	if (start_monitor(&table))
+		return (-1);
+	pthread_join(feed, NULL);
+	join_monitor(&table);
+	latency = (double)(get_time_ns() - deadline) / NS_PER_MS;
+	cleanup_table(&table);
+	return (latency);
+}
+
+static double	median(double *v)
+{
+	double	t;
+	int		i;
+	int		j;
+
+	i = 0;
+	while (++i < REPS)
+	{
+		j = i;
+		while (j > 0 && v[j - 1] > v[j])
+		{
+			t = v[j];
+			v[j] = v[j - 1];
+			v[j - 1] = t;
+			j--;
+		}
+	}
+	return (v[REPS / 2]);
+}
+
+static void	run(char *count)
+{
+	static int	shards[] = {1, 2, 4, 8};
+	double		v[REPS];
+	int			s;
+	int			r;
+
+	printf("%7s |", count);
+	s = 0;
+	while (s < 4)
+	{
+		r = 0;
+		while (r < REPS)
+		{
+			v[r] = run_once(count, shards[s]);
+			r++;
+		}
+		printf(" %d: %8.3f ms |", shards[s], median(v));
+		fflush(stdout);
+		s++;
+	}
+	printf("\n");
+}
+
+int	main(void)
+{
+	static char	*counts[] = {"1000", "10000", "50000", "200000", NULL};
+	int			i;
+
+	printf(BLUE "=== Death detection latency by monitor shards (%ld CPUs) ==="
+		RESET "\n", sysconf(_SC_NPROCESSORS_ONLN));
+	i = 0;
+	while (counts[i])
+		run(counts[i++]);
+	return (0);
+}
@@ -0,0 +1,228 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_sleep.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+#include <sys/resource.h>
+
+/*
+** Benchmark: sleep-timing jitter of every sleeper in the time layer.
+** Each sleeper runs across a sweep of durations (1 ms to 1 s) and
+** thread counts (1, 1x, 2x and 4x the online cores), every thread
+** sleeping back to back. For each cell it prints the overshoot past
+** the requested duration (p50/p99/p999/max, in us, over all threads)
+** and the CPU time the process burnt per wall second.
+**   precise    : precise_sleep(), usleep(100) polling
+**   philo-old  : philo's smart_sleep() before calibration (10/5 ms
+**                margins, then 1 ms / 200 us steps)
+**   bonus-old  : philo_bonus' smart_sleep() before calibration (90%
+**                bulk usleep, then usleep(50) polling)
+**   abs        : sleep_until() with --sleep-calib off (one
+**                clock_nanosleep(TIMER_ABSTIME))
+**   calibrated : smart_sleep() after calibrate_sleep() (the default)
+**   wheel      : wheel_sleep() on a running --timer wheel
+** Each thread takes about <budget> ms of samples (at least 2).
+**
+** Build/run from philo/: make bench_sleep && ./bench_sleep [budget_ms]
+** [max_duration_ms]
+*/
+
+#define BLUE "\033[0;34m"
+#define RESET "\033[0m"
+#define SLEEPERS 6
+#define MAX_THREADS 256
+
+typedef struct s_cell
+{
+	int			sleeper;
+	long		duration;
+	int			samples;
+	t_table		*table;
+	long		*out;
+	pthread_t	thread;
+}	t_cell;
+
+static const char	*g_names[SLEEPERS] = {"precise", "philo-old",
+	"bonus-old", "abs", "calibrated", "wheel"};
+static t_calib		g_calib;
+
+static void	philo_old_sleep(long duration)
+{
+	long	end;
+	long	remaining;
+
+	end = get_mono_ns() + duration * NS_PER_MS;
+	while (1)
+	{
+		remaining = (end - get_mono_ns()) / 1000;
+		if (remaining <= 0)
+			break ;
+		if (remaining > 10000)
+			usleep(remaining - 5000);
+		else if (remaining > 2000)
+			usleep(1000);
+		else
+			usleep(200);
+	}
+}
+
+static void	bonus_old_sleep(long duration)
+{
+	long	end;
+
+	end = get_mono_ns() + duration * NS_PER_MS;
+	if (duration * 9 / 10 > 0)
+		usleep(duration * 9 / 10 * 1000);
+	while (get_mono_ns() < end)
+		usleep(50);
+}
+
+static void	*cell_routine(void *arg)
+{
+	t_cell	*c;
+	t_timer	timer;
+	long	start;
+	int		i;
+
+	c = (t_cell *)arg;
+	i = 0;
+	while (i < c->samples)
+	{
+		start = get_mono_ns();
+		if (c->sleeper == 0)
+			precise_sleep(c->duration);
+		else if (c->sleeper == 1)
+			philo_old_sleep(c->duration);
+		else if (c->sleeper == 2)
+			bonus_old_sleep(c->duration);
+		else if (c->sleeper == 5)
+			wheel_sleep(&c->table->wheel, &timer,
+				start + c->duration * NS_PER_MS);
+		else
+			smart_sleep(c->duration);
+		c->out[i++] = get_mono_ns() - start - c->duration * NS_PER_MS;
+	}
+	return (NULL);
+}
+
+static int	cmp_long(const void *a, const void *b)
+{
+	return ((*(const long *)a > *(const long *)b)
+		- (*(const long *)a < *(const long *)b));
+}
+
+static long	cpu_ns(void)
+{
+	struct rusage	ru;
+
+	getrusage(RUSAGE_SELF, &ru);
+	return ((ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * NS_PER_SEC
+		+ (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1000L);
+}
+
+/* Runs one (sleeper, duration, threads) cell and prints its row */
+static void	run_cell(t_cell *proto, int threads, long *all)
+{
+	t_cell	cells[MAX_THREADS];
+	long	wall;
+	long	cpu;
+	long	n;
+	int		i;
+
+	*sleep_calib() = g_calib;
+	if (proto->sleeper == 3)
+	{
+		sleep_calib()->margin_ns = 0;
+		sleep_calib()->spin_ns = 0;
+	}
+	wall = get_mono_ns();
+	cpu = cpu_ns();
+	i = -1;
+	while (++i < threads)
+	{
+		cells[i] = *proto;
+		cells[i].out = all + (long)i * proto->samples;
+		pthread_create(&cells[i].thread, NULL, cell_routine, &cells[i]);
+	}
+	while (i-- > 0)
+		pthread_join(cells[i].thread, NULL);
+	wall = get_mono_ns() - wall;
+	cpu = cpu_ns() - cpu;
+	n = (long)threads * proto->samples;
+	qsort(all, n, sizeof(long), cmp_long);
+	printf("%-10s %5ld %4d %6ld %9.1f %9.1f %9.1f %9.1f %8.1f\n",
+		g_names[proto->sleeper], proto->duration, threads, n,
+		all[n / 2] / 1000.0, all[n * 99 / 100] / 1000.0,
+		all[n * 999 / 1000] / 1000.0, all[n - 1] / 1000.0,
+		(double)cpu / wall * 1000);
+}
+
+static void	sweep(t_cell *proto, long budget, long max_ms, long *all)
+{
+	static const long	durations[] = {1, 10, 100, 1000, 0};
+	int					mult[4];
+	int					m;
+	int					d;
+
+	mult[0] = 1;
+	mult[1] = sysconf(_SC_NPROCESSORS_ONLN);
+	mult[2] = mult[1] * 2;
+	mult[3] = mult[1] * 4;
+	d = -1;
+	while (durations[++d] && durations[d] <= max_ms)
+	{
+		proto->duration = durations[d];
+		proto->samples = budget / durations[d];
+		if (proto->samples < 2)
+			proto->samples = 2;
+		m = -1;
+		while (++m < 4)
+			if ((m == 0 || mult[m] != mult[m - 1]) && mult[m] <= MAX_THREADS)
+				run_cell(proto, mult[m], all);
+	}
+}
+
+int	main(int argc, char **argv)
+{
+	static char	*args[] = {"philo", "1", "800", "200", "200", NULL};
+	t_table		table;
+	t_cell		proto;
+	long		budget;
+	long		max_ms;
+	long		*all;
+
+	budget = 300;
+	max_ms = 1000;
+	if (argc > 1)
+		budget = atol(argv[1]);
+	if (argc > 2)
+		max_ms = atol(argv[2]);
+	memset(&table, 0, sizeof(table));
+	table.opts.timer = TM_WHEEL;
+	all = malloc(sizeof(long) * MAX_THREADS * (budget + 2));
+	if (budget < 1 || !all || parse_arguments(&table, 5, args)
+		|| init_table(&table) || start_wheel(&table))
+		return (1);
+	calibrate_sleep(1);
+	g_calib = *sleep_calib();
+	printf(BLUE "=== Sleep jitter benchmark (%ld cores, overshoot in us) ==="
+		RESET "\n%-10s %5s %4s %6s %9s %9s %9s %9s %8s\n",
+		sysconf(_SC_NPROCESSORS_ONLN), "sleeper", "ms", "thr", "n", "p50",
+		"p99", "p999", "max", "cpu ms/s");
+	proto.table = &table;
+	proto.sleeper = -1;
+	while (++proto.sleeper < SLEEPERS)
+		sweep(&proto, budget, max_ms, all);
+	stop_wheel(&table);
+	cleanup_table(&table);
+	free(all);
+	return (0);
+}
@@ -0,0 +1,209 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   bench_timer.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+/*
+** Benchmark: cost of timing the phases, per simulated second.
+** Runs ./philo <n> 800 200 200 <meals> (no deaths, output to /dev/null)
+** once per mode and reads the child's rusage with wait4():
+**   local/nocalib : each thread clock_nanosleep()s itself, no spin
+**   local         : same, calibrated (default: no tail when the
+**                   philosophers outnumber the CPUs)
+**   wheel         : one timer thread, philosophers futex-wait (--timer)
+** The second half times the phases alone, the way the old polling
+** design did them: a forked child runs <n> threads of <meals> eat +
+** sleep cycles (200 ms each, no forks, no monitor, no output) with
+**   polling       : philo's smart_sleep() before absolute deadlines
+**                   (copied here: 10/5 ms margins, then 1 ms / 200 us
+**                   usleep() steps)
+**   abs           : phase_sleep() with --sleep-calib off
+**   calibrated    : phase_sleep() with the yield/spin tail forced on
+**   wheel         : phase_sleep() on a running --timer wheel
+** "ctxsw" is voluntary + involuntary context switches, "cpu" is user +
+** system time, both divided by the wall time of the run.
+**
+** Build/run from philo/ after make: make bench_timer && ./bench_timer [n]
+** [meals]
+*/
+
+#define BLUE "\033[0;34m"
+#define RESET "\033[0m"
+#define PHASE_MS 200
+
+typedef struct s_phases
+{
+	t_philo		*philo;
+	int			sleeper;
+	long		meals;
+	pthread_t	thread;
+}	t_phases;
+
+static void	report(const char *name, long start, struct rusage *ru)
+{
+	double	wall;
+
+	wall = (double)(get_mono_ns() - start) / NS_PER_SEC;
+	printf("%-14s: %6.2f s | ctxsw %9.0f /s | cpu %7.1f ms/s\n", name, wall,
+		(ru->ru_nvcsw + ru->ru_nivcsw) / wall,
+		(ru->ru_utime.tv_sec + ru->ru_stime.tv_sec) * 1000.0 / wall
+		+ (ru->ru_utime.tv_usec + ru->ru_stime.tv_usec) / 1000.0 / wall);
+}
+
+static void	run(const char *name, char *count, char *meals, char **extra)
+{
+	char			*args[10];
+	struct rusage	ru;
+	long			start;
+	pid_t			pid;
+
+	args[0] = "./philo";
+	args[1] = count;
+	args[2] = "800";
+	args[3] = "200";
+	args[4] = "200";
+	args[5] = meals;
+	args[6] = extra[0];
+	args[7] = extra[1];
+	args[8] = extra[2];
+	args[9] = extra[3];
+	start = get_mono_ns();
+	pid = fork();
+	if (pid == 0)
+	{
+		dup2(open("/dev/null", O_WRONLY), STDOUT_FILENO);
+		execv(args[0], args);
+		_exit(127);
+	}
+	if (pid < 0 || wait4(pid, NULL, 0, &ru) < 0)
+		return ;
+	report(name, start, &ru);
+}
+
+static void	polling_sleep(long duration)
+{
+	long	end;
+	long	remaining;
+
+	end = get_mono_ns() + duration * NS_PER_MS;
+	while (1)
+	{
+		remaining = (end - get_mono_ns()) / 1000;
+		if (remaining <= 0)
+			break ;
+		if (remaining > 10000)
+			usleep(remaining - 5000);
+		else if (remaining > 2000)
+			usleep(1000);
+		else
+			usleep(200);
+	}
+}
+
+static void	*phases_routine(void *arg)
+{
+	t_phases	*p;
+	long		i;
+
+	p = (t_phases *)arg;
+	i = 0;
+	while (i++ < p->meals * 2)
+	{
+		if (p->sleeper == 0)
+			polling_sleep(PHASE_MS);
+		else
+			phase_sleep(p->philo, PHASE_MS);
+	}
+	return (NULL);
+}
+
+/* Child side of run_phases(): the threads, then exit with their status */
+static int	phases_child(int sleeper, char *count, long meals)
+{
+	static char	*args[] = {"philo", NULL, "800", "200", "200", NULL};
+	t_table		table;
+	t_phases	*p;
+	int			i;
+
+	args[1] = count;
+	memset(&table, 0, sizeof(table));
+	if (sleeper == 3)
+		table.opts.timer = TM_WHEEL;
+	sleep_calib()->mode = CAL_OFF;
+	if (sleeper == 2)
+		sleep_calib()->mode = CAL_AUTO;
+	calibrate_sleep(1);
+	if (parse_arguments(&table, 5, args) || init_table(&table)
+		|| start_wheel(&table))
+		return (1);
+	p = calloc(table.philo_count, sizeof(t_phases));
+	if (!p)
+		return (1);
+	i = -1;
+	while (++i < table.philo_count)
+	{
+		p[i] = (t_phases){&table.philos[i], sleeper, meals, 0};
+		pthread_create(&p[i].thread, NULL, phases_routine, &p[i]);
+	}
+	while (i-- > 0)
+		pthread_join(p[i].thread, NULL);
+	free(p);
+	stop_wheel(&table);
+	cleanup_table(&table);
+	return (0);
+}
+
+static void	run_phases(const char *name, int sleeper, char *count, long meals)
+{
+	struct rusage	ru;
+	long			start;
+	pid_t			pid;
+
+	fflush(stdout);
+	start = get_mono_ns();
+	pid = fork();
+	if (pid == 0)
+		_exit(phases_child(sleeper, count, meals));
+	if (pid < 0 || wait4(pid, NULL, 0, &ru) < 0)
+		return ;
+	report(name, start, &ru);
+}
+
+int	main(int argc, char **argv)
+{
+	static char	*nocalib[] = {"--sleep-calib", "off", NULL, NULL};
+	static char	*local[] = {"--timer", "local", NULL, NULL};
+	static char	*wheel[] = {"--timer", "wheel", "--sleep-calib", "off"};
+	char		*count;
+	char		*meals;
+
+	count = "200";
+	meals = "10";
+	if (argc > 1)
+		count = argv[1];
+	if (argc > 2)
+		meals = argv[2];
+	printf(BLUE "=== Timer benchmark (./philo %s 800 200 200 %s) ==="
+		RESET "\n", count, meals);
+	run("local/nocalib", count, meals, nocalib);
+	run("local", count, meals, local);
+	run("wheel", count, meals, wheel);
+	printf(BLUE "=== Phases only (%s threads, %s x %dms eat + %dms sleep) ==="
+		RESET "\n", count, meals, PHASE_MS, PHASE_MS);
+	run_phases("polling", 0, count, atol(meals));
+	run_phases("abs", 1, count, atol(meals));
+	run_phases("calibrated", 2, count, atol(meals));
+	run_phases("wheel", 3, count, atol(meals));
+	return (0);
+}
@@ -63,13 +63,11 @@ void	test_init_mutexes(void)
 		"write_lock mutex is functional");
 	pthread_mutex_unlock(&table.write_lock);
 	
-	TEST_ASSERT(pthread_mutex_lock(&table.meal_lock) == 0,
-		"meal_lock mutex is functional");
-	pthread_mutex_unlock(&table.meal_lock);
-	
-	TEST_ASSERT(pthread_mutex_lock(&table.sim_lock) == 0,
-		"sim_lock mutex is functional");
-	pthread_mutex_unlock(&table.sim_lock);
+	TEST_ASSERT(atomic_is_lock_free(&table.simulation_end),
+		"simulation_end is lock-free");
+	TEST_ASSERT(((unsigned long)&table.simulation_end % 64) == 0
+		&& ((unsigned long)&table.forks % 64) == 0,
+		"simulation_end has its own cache line");
 	
 	/* Test all fork mutexes */
 	i = 0;
@@ -130,6 +128,14 @@ void	test_init_philosophers(void)
 	TEST_ASSERT(table.philos[4].meals_count == 0,
 		"all philosophers start with meals_count = 0");
 	
+	/* Test the lock-free meal state layout */
+	TEST_ASSERT(atomic_is_lock_free(&table.philos[0].last_meal_time)
+		&& atomic_is_lock_free(&table.philos[0].meals_count),
+		"meal state atomics are lock-free");
+	TEST_ASSERT(((unsigned long)&table.philos[1].last_meal_time % 64) == 0
+		&& ((unsigned long)&table.philos[1].id % 64) == 0,
+		"meal state sits alone on its cache line");
+	
 	/* Test fork assignments (circular) */
 	TEST_ASSERT(table.philos[0].left_fork == &table.forks[0],
 		"philosopher 1 left fork is fork 0");
@@ -163,16 +169,16 @@ void	test_init_table(void)
 	parse_arguments(&table, 5, args);
 	
 	/* Test initialization */
-	time_before = get_time_ms();
+	time_before = get_time_ns();
 	TEST_ASSERT(init_table(&table) == 0,
 		"init_table succeeds with valid table");
-	time_after = get_time_ms();
+	time_after = get_time_ns();
 	
 	/* Verify simulation_end is false */
 	TEST_ASSERT(table.simulation_end == false,
 		"simulation_end initialized to false");
 	
-	/* Verify start_time is set correctly */
+	/* Verify start_time is set correctly (monotonic ns) */
 	TEST_ASSERT(table.start_time >= time_before && table.start_time <= time_after,
 		"start_time is set to current time");
 	
@@ -250,13 +256,11 @@ void	test_integration_mutex_locking(void)
 	
 	/* Test concurrent locking/unlocking */
 	pthread_mutex_lock(&table.write_lock);
-	pthread_mutex_lock(&table.meal_lock);
-	pthread_mutex_lock(&table.sim_lock);
+	pthread_mutex_lock(&table.forks[0]);
 	
 	TEST_ASSERT(1, "multiple mutexes can be locked simultaneously");
 	
-	pthread_mutex_unlock(&table.sim_lock);
-	pthread_mutex_unlock(&table.meal_lock);
+	pthread_mutex_unlock(&table.forks[0]);
 	pthread_mutex_unlock(&table.write_lock);
 	
 	TEST_ASSERT(1, "mutexes unlock in reverse order successfully");
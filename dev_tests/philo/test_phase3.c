@@ -198,6 +198,41 @@ void	test_eat_action(void)
 	cleanup_table(&table);
 }
 
+void	test_must_eat_completion(void)
+{
+	t_table	table;
+	char	*args[] = {"./philo", "2", "800", "10", "200", "1"};
+
+	TEST_SECTION("Testing must-eat completion (count_satisfied)");
+	
+	memset(&table, 0, sizeof(t_table));
+	parse_arguments(&table, 6, args);
+	init_table(&table);
+	
+	take_forks(&table.philos[0]);
+	eat_action(&table.philos[0]);
+	drop_forks(&table.philos[0]);
+	TEST_ASSERT(!all_philosophers_satisfied(&table)
+		&& !should_end_simulation(&table),
+		"one of two philosophers done does not end the simulation");
+	
+	take_forks(&table.philos[0]);
+	eat_action(&table.philos[0]);
+	drop_forks(&table.philos[0]);
+	TEST_ASSERT(atomic_load(&table.satisfied) == 1,
+		"a philosopher is counted once, not on every later meal");
+	
+	take_forks(&table.philos[1]);
+	eat_action(&table.philos[1]);
+	drop_forks(&table.philos[1]);
+	TEST_ASSERT(all_philosophers_satisfied(&table),
+		"all_philosophers_satisfied once every philosopher is done");
+	TEST_ASSERT(should_end_simulation(&table),
+		"the last philosopher to finish ends the simulation");
+	
+	cleanup_table(&table);
+}
+
 void	test_sleep_action(void)
 {
 	t_table	table;
@@ -379,6 +414,316 @@ void	test_integration_deadlock_prevention(void)
 	cleanup_table(&table);
 }
 
+void	test_fork_strategies(void)
+{
+	static char	*names[] = {"hierarchy", "even-odd", "waiter",
+		"chandy-misra", "edf", NULL};
+	t_table		table;
+	char		*args[] = {"./philo", "5", "1000", "50", "50"};
+	int			s;
+	int			i;
+
+	TEST_SECTION("Integration Test: Fork Strategies (--forks)");
+	
+	memset(&table, 0, sizeof(t_table));
+	TEST_ASSERT(opt_forks(&table, "bogus") != 0,
+		"opt_forks rejects an unknown strategy");
+	s = 0;
+	while (names[s])
+	{
+		memset(&table, 0, sizeof(t_table));
+		parse_arguments(&table, 5, args);
+		opt_forks(&table, names[s]);
+		init_table(&table);
+		create_threads(&table);
+		usleep(300000);
+		TEST_ASSERT(!should_end_simulation(&table),
+			"strategy runs without deadlock");
+		end_simulation(&table);
+		join_threads(&table);
+		i = 0;
+		while (i < table.philo_count
+			&& atomic_load(&table.philos[i].meals_count) > 0)
+			i++;
+		TEST_ASSERT(i == table.philo_count, "every philosopher has eaten");
+		cleanup_table(&table);
+		s++;
+	}
+}
+
+static void	*cm_neighbor(void *arg)
+{
+	cm_acquire(arg);
+	return (NULL);
+}
+
+void	test_chandy_misra_bound(void)
+{
+	t_table		table;
+	t_cm_fork	*shared;
+	pthread_t	tid;
+	char		*args[] = {"./philo", "3", "800", "200", "200"};
+	bool		waiting;
+
+	TEST_SECTION("Unit Test: Chandy-Misra Waits One Neighbor Meal");
+	
+	memset(&table, 0, sizeof(t_table));
+	parse_arguments(&table, 5, args);
+	opt_forks(&table, "chandy-misra");
+	init_table(&table);
+	/* Fork 1 sits between philosophers 1 and 2 (indices 0 and 1) */
+	shared = &table.cm_forks[1];
+	cm_acquire(&table.philos[0]);
+	pthread_create(&tid, NULL, cm_neighbor, &table.philos[1]);
+	waiting = false;
+	while (!waiting)
+	{
+		usleep(1000);
+		pthread_mutex_lock(&shared->lock);
+		waiting = shared->requested;
+		pthread_mutex_unlock(&shared->lock);
+	}
+	cm_release(&table.philos[0]);
+	pthread_join(tid, NULL);
+	TEST_ASSERT(shared->owner == 1 && shared->in_use,
+		"released fork goes to the waiting neighbor");
+	cm_release(&table.philos[1]);
+	TEST_ASSERT(shared->owner == 1 && shared->dirty,
+		"fork stays with the neighbor until it has eaten");
+	cm_acquire(&table.philos[0]);
+	TEST_ASSERT(shared->owner == 0 && shared->in_use,
+		"dirty fork can be taken back after that meal");
+	cm_release(&table.philos[0]);
+	end_simulation(&table);
+	cleanup_table(&table);
+}
+
+static void	*edf_requester(void *arg)
+{
+	edf_acquire(arg);
+	return (NULL);
+}
+
+void	test_edf_order(void)
+{
+	t_table		table;
+	pthread_t	tid[2];
+	char		*args[] = {"./philo", "3", "800", "200", "200"};
+	int			hungry;
+
+	TEST_SECTION("Unit Test: EDF Grants The Earliest Deadline");
+	
+	memset(&table, 0, sizeof(t_table));
+	parse_arguments(&table, 5, args);
+	opt_forks(&table, "edf");
+	init_table(&table);
+	/* 2 and 3 both need a fork of 1; 3 is 100 ms closer to dying */
+	atomic_store(&table.philos[2].last_meal_time,
+		table.start_time - 100 * NS_PER_MS);
+	edf_acquire(&table.philos[0]);
+	pthread_create(&tid[0], NULL, edf_requester, &table.philos[1]);
+	pthread_create(&tid[1], NULL, edf_requester, &table.philos[2]);
+	hungry = 0;
+	while (hungry < 2)
+	{
+		usleep(1000);
+		while (atomic_load(&table.edf.busy))
+			usleep(100);
+		hungry = table.edf.hungry_count;
+	}
+	edf_release(&table.philos[0]);
+	pthread_join(tid[1], NULL);
+	TEST_ASSERT(atomic_load(&table.edf.slots[2].eating)
+		&& !atomic_load(&table.edf.slots[1].eating),
+		"released forks go to the earliest deadline");
+	edf_release(&table.philos[2]);
+	pthread_join(tid[0], NULL);
+	TEST_ASSERT(atomic_load(&table.edf.slots[1].eating),
+		"the later deadline eats next");
+	edf_release(&table.philos[1]);
+	end_simulation(&table);
+	cleanup_table(&table);
+}
+
+typedef struct s_lock_test
+{
+	t_table		*table;
+	long		count;
+	atomic_int	got;
+	atomic_int	done;
+}	t_lock_test;
+
+static void	*flock_counter(void *arg)
+{
+	t_lock_test	*t;
+	int			i;
+
+	t = arg;
+	i = 0;
+	while (i++ < 20000)
+	{
+		fork_lock(t->table, 0);
+		t->count++;
+		fork_unlock(t->table, 0);
+	}
+	return (NULL);
+}
+
+static void	*flock_waiter(void *arg)
+{
+	t_lock_test	*t;
+
+	t = arg;
+	fork_lock(t->table, 1);
+	atomic_store(&t->got, 1);
+	while (!atomic_load(&t->done))
+		usleep(1000);
+	fork_unlock(t->table, 1);
+	return (NULL);
+}
+
+void	test_futex_fork_lock(void)
+{
+	t_table		table;
+	t_lock_test	t;
+	pthread_t	tid[4];
+	char		*args[] = {"./philo", "5", "800", "200", "200"};
+	int			i;
+
+	TEST_SECTION("Unit Test: Futex Fork Lock (--fork-lock futex)");
+	
+	memset(&table, 0, sizeof(t_table));
+	TEST_ASSERT(opt_fork_lock(&table, "bogus") != 0,
+		"opt_fork_lock rejects an unknown kind");
+	parse_arguments(&table, 5, args);
+	opt_fork_lock(&table, "futex");
+	opt_forks(&table, "waiter");
+	TEST_ASSERT(init_table(&table) != 0,
+		"--fork-lock futex is refused with --forks waiter");
+	memset(&table, 0, sizeof(t_table));
+	parse_arguments(&table, 5, args);
+	opt_fork_lock(&table, "futex");
+	init_table(&table);
+	memset(&t, 0, sizeof(t));
+	t.table = &table;
+	i = -1;
+	while (++i < 4)
+		pthread_create(&tid[i], NULL, flock_counter, &t);
+	while (i-- > 0)
+		pthread_join(tid[i], NULL);
+	TEST_ASSERT(t.count == 80000, "futex lock excludes concurrent holders");
+	fork_lock(&table, 1);
+	pthread_create(&tid[0], NULL, flock_waiter, &t);
+	while (atomic_load(&table.flocks[1].waiters) == 0)
+		usleep(1000);
+	fork_unlock(&table, 1);
+	TEST_ASSERT(!fork_trylock(&table, 1),
+		"unlock hands the fork to the waiter, releaser cannot retake it");
+	atomic_store(&t.done, 1);
+	pthread_join(tid[0], NULL);
+	TEST_ASSERT(atomic_load(&t.got) == 1, "waiter gets the fork");
+	TEST_ASSERT(fork_trylock(&table, 1), "fork is free once it is back");
+	fork_unlock(&table, 1);
+	cleanup_table(&table);
+}
+
+typedef struct s_ticket_test
+{
+	t_table		*table;
+	atomic_int	turn;
+	int			order[2];
+}	t_ticket_test;
+
+typedef struct s_ticket_arg
+{
+	t_ticket_test	*shared;
+	int				id;
+}	t_ticket_arg;
+
+static void	*ticket_waiter(void *arg)
+{
+	t_ticket_arg	*a;
+
+	a = arg;
+	fork_lock(a->shared->table, 2);
+	a->shared->order[atomic_fetch_add(&a->shared->turn, 1)] = a->id;
+	fork_unlock(a->shared->table, 2);
+	return (NULL);
+}
+
+/* Calls report_fork_lock() with stderr sent to a file, returns its text */
+static void	capture_report(t_table *table, char *buf, size_t size)
+{
+	int		saved;
+	int		fd;
+	ssize_t	len;
+
+	fd = open("/tmp/philo_test_report.txt", O_RDWR | O_CREAT | O_TRUNC, 0644);
+	saved = dup(STDERR_FILENO);
+	dup2(fd, STDERR_FILENO);
+	report_fork_lock(table);
+	dup2(saved, STDERR_FILENO);
+	close(saved);
+	len = pread(fd, buf, size - 1, 0);
+	buf[len > 0 ? len : 0] = '\0';
+	close(fd);
+	unlink("/tmp/philo_test_report.txt");
+}
+
+void	test_ticket_fork_lock(void)
+{
+	t_table			table;
+	t_ticket_test	t;
+	t_ticket_arg	a[2];
+	pthread_t		tid[2];
+	char			*args[] = {"./philo", "5", "800", "200", "200"};
+	char			report[4096];
+	int				i;
+
+	TEST_SECTION("Unit Test: Ticket Fork Lock (--fork-lock ticket)");
+	
+	memset(&table, 0, sizeof(t_table));
+	parse_arguments(&table, 5, args);
+	opt_fork_lock(&table, "ticket");
+	opt_forks(&table, "chandy-misra");
+	TEST_ASSERT(init_table(&table) != 0,
+		"--fork-lock ticket is refused with --forks chandy-misra");
+	memset(&table, 0, sizeof(t_table));
+	parse_arguments(&table, 5, args);
+	opt_fork_lock(&table, "ticket");
+	init_table(&table);
+	capture_report(&table, report, sizeof(report));
+	TEST_ASSERT(strstr(report, "no philosopher queued")
+		&& !strstr(report, "max"), "no bound is reported without a wait");
+	memset(&t, 0, sizeof(t));
+	t.table = &table;
+	fork_lock(&table, 2);
+	/* Queue waiter 0, then waiter 1, behind the main thread */
+	i = -1;
+	while (++i < 2)
+	{
+		a[i].shared = &t;
+		a[i].id = i;
+		pthread_create(&tid[i], NULL, ticket_waiter, &a[i]);
+		while (atomic_load(&table.tlocks[2].next) != (unsigned)i + 2)
+			usleep(1000);
+	}
+	TEST_ASSERT(!fork_trylock(&table, 2), "trylock fails while others queue");
+	usleep(10000);
+	fork_unlock(&table, 2);
+	while (i-- > 0)
+		pthread_join(tid[i], NULL);
+	TEST_ASSERT(t.order[0] == 0 && t.order[1] == 1,
+		"fork is granted in arrival order");
+	TEST_ASSERT(table.tlocks[2].waits == 2, "both waits are counted");
+	TEST_ASSERT(table.tlocks[2].max_wait >= 10 * NS_PER_MS,
+		"max queue wait covers the holder's critical section");
+	capture_report(&table, report, sizeof(report));
+	TEST_ASSERT(strstr(report, "(2 waits)") && strstr(report, "at fork 3"),
+		"report names the worst fork");
+	cleanup_table(&table);
+}
+
 void	test_edge_case_single_philosopher(void)
 {
 	t_table	table;
@@ -428,6 +773,331 @@ void	test_thread_safety(void)
 	cleanup_table(&table);
 }
 
+/* ************************************************************************** */
+/*                              OUTPUT TESTS                                  */
+/* ************************************************************************** */
+
+#define OUT_PATH "/tmp/philo_test_out.txt"
+
+typedef struct s_scan
+{
+	int		lines;
+	int		backwards;
+	bool	died_last;
+}	t_scan;
+
+/* Runs a whole simulation like main(), text output to OUT_PATH */
+static int	run_to_file(t_table *table, char **args, int argc)
+{
+	table->opts.out_path = OUT_PATH;
+	if (parse_arguments(table, argc, args) != 0 || init_table(table) != 0)
+		return (1);
+	if (open_sink(table) != 0 || open_trace(table) != 0
+		|| start_logger(table) != 0 || start_outq(table) != 0
+		|| create_threads(table) != 0 || start_monitor(table) != 0)
+	{
+		stop_logger(table);
+		stop_outq(table);
+		cleanup_table(table);
+		return (1);
+	}
+	join_monitor(table);
+	join_threads(table);
+	stop_logger(table);
+	stop_outq(table);
+	cleanup_table(table);
+	return (0);
+}
+
+/*
+** Counts the lines of OUT_PATH and the timestamps that go backwards,
+** and tells whether the last line is a death
+*/
+static void	scan_output(t_scan *s)
+{
+	FILE	*f;
+	char	line[128];
+	long	ts;
+	long	prev;
+
+	memset(s, 0, sizeof(*s));
+	f = fopen(OUT_PATH, "r");
+	if (!f)
+		return ;
+	prev = 0;
+	while (fgets(line, sizeof(line), f))
+	{
+		ts = atol(line);
+		s->backwards += (ts < prev);
+		prev = ts;
+		s->lines++;
+		s->died_last = (strstr(line, " died") != NULL);
+	}
+	fclose(f);
+}
+
+void	test_output_order(void)
+{
+	t_table	table;
+	t_scan	s;
+	char	*args[] = {"./philo", "200", "800", "200", "200", "5"};
+
+	TEST_SECTION("Output Test: Timestamps In Order (200 philosophers)");
+	
+	memset(&table, 0, sizeof(t_table));
+	TEST_ASSERT(run_to_file(&table, args, 6) == 0, "simulation runs");
+	scan_output(&s);
+	TEST_ASSERT(s.lines >= 200 * 5 * 4, "every meal is printed");
+	TEST_ASSERT(s.backwards == 0, "timestamps never decrease");
+	unlink(OUT_PATH);
+}
+
+/* Reads the philosopher id of every line of OUT_PATH, returns the count */
+static int	read_ids(int *ids, int max, int *died_at)
+{
+	FILE	*f;
+	char	line[128];
+	int		n;
+
+	*died_at = -1;
+	f = fopen(OUT_PATH, "r");
+	if (!f)
+		return (0);
+	n = 0;
+	while (n < max && fgets(line, sizeof(line), f))
+	{
+		sscanf(line, "%*d %d", &ids[n]);
+		if (strstr(line, " died"))
+			*died_at = n;
+		n++;
+	}
+	fclose(f);
+	return (n);
+}
+
+/* Publishes an event with a chosen timestamp in ring r */
+static void	ring_put(t_table *table, int r, long ts, int id, t_state state)
+{
+	t_ring			*ring;
+	unsigned long	tail;
+
+	ring = &table->log.rings[r];
+	tail = atomic_load(&ring->tail);
+	ring->slots[tail & (LOG_RING_SIZE - 1)].ts = ts;
+	ring->slots[tail & (LOG_RING_SIZE - 1)].id = id;
+	ring->slots[tail & (LOG_RING_SIZE - 1)].state = state;
+	atomic_store(&ring->tail, tail + 1);
+}
+
+void	test_async_log_merge(void)
+{
+	t_table	table;
+	t_scan	s;
+	int		ids[16];
+	int		died_at;
+	int		n;
+	char	*args[] = {"./philo", "3", "800", "200", "200"};
+	char	*big[] = {"./philo", "200", "800", "200", "200", "5"};
+	char	*death[] = {"./philo", "4", "310", "200", "100"};
+
+	TEST_SECTION("Output Test: Async Log Merge (--async-log)");
+	
+	/* The writer thread is stopped at once; rounds are driven by hand */
+	memset(&table, 0, sizeof(t_table));
+	table.opts.async_log = true;
+	table.opts.out_path = OUT_PATH;
+	parse_arguments(&table, 5, args);
+	init_table(&table);
+	open_sink(&table);
+	start_logger(&table);
+	stop_logger(&table);
+	ring_put(&table, 0, 5, 1, ST_EAT);
+	ring_put(&table, 0, 9, 1, ST_SLEEP);
+	ring_put(&table, 1, 3, 2, ST_EAT);
+	ring_put(&table, 1, 12, 2, ST_SLEEP);
+	ring_put(&table, 2, 7, 3, ST_EAT);
+	logger_round(&table, 10);
+	TEST_ASSERT(table.log.heap_len == 1, "events at or past the limit wait");
+	ring_put(&table, 2, 11, 3, ST_SLEEP);
+	ring_put(&table, 3, 11, 2, ST_DIED);
+	ring_put(&table, 0, 13, 1, ST_THINK);
+	logger_round(&table, -1);
+	cleanup_table(&table);
+	n = read_ids(ids, 16, &died_at);
+	TEST_ASSERT(n == 6 && ids[0] == 2 && ids[1] == 1 && ids[2] == 3
+		&& ids[3] == 1 && ids[4] == 3, "rings are merged in timestamp order");
+	TEST_ASSERT(died_at == 5 && ids[5] == 2,
+		"same-ms events print first, nothing prints after the death");
+	memset(&table, 0, sizeof(t_table));
+	table.opts.async_log = true;
+	run_to_file(&table, big, 6);
+	scan_output(&s);
+	TEST_ASSERT(s.lines >= 200 * 5 * 4 && s.backwards == 0,
+		"200 philosophers: every line, timestamps never decrease");
+	memset(&table, 0, sizeof(t_table));
+	table.opts.async_log = true;
+	run_to_file(&table, death, 5);
+	scan_output(&s);
+	TEST_ASSERT(s.lines > 0 && s.backwards == 0 && s.died_last,
+		"a run with a death ends with the death line");
+	unlink(OUT_PATH);
+}
+
+#define TRACE_PATH "/tmp/philo_test_trace.bin"
+
+/* Decodes TRACE_PATH into OUT_PATH with trace_decode() */
+static int	decode_to_out(void)
+{
+	FILE	*in;
+	FILE	*out;
+	int		ret;
+
+	in = fopen(TRACE_PATH, "rb");
+	out = fopen(OUT_PATH, "w");
+	ret = (!in || !out || trace_decode(in, out) != 0);
+	if (in)
+		fclose(in);
+	if (out)
+		fclose(out);
+	return (ret);
+}
+
+/*
+** Records events with trace_record() and formats the same events with
+** fmt_line(), then checks that trace_decode() gives back that text.
+** Returns the trace size in bytes, -1 if the text differs.
+*/
+static long	trace_roundtrip(char *count, const long *ts, int n)
+{
+	t_table	table;
+	char	*args[] = {"./philo", count, "800", "200", "200"};
+	char		expected[4096];
+	char		decoded[4096];
+	size_t		len;
+	int			fd;
+	struct stat	st;
+	int			i;
+
+	memset(&table, 0, sizeof(t_table));
+	table.opts.trace_path = TRACE_PATH;
+	parse_arguments(&table, 5, args);
+	init_table(&table);
+	open_trace(&table);
+	len = 0;
+	i = -1;
+	while (++i < n)
+	{
+		trace_record(&table.trace, ts[i], table.philo_count - i, i % 5);
+		len += fmt_line(expected + len, ts[i],
+				&table.philos[table.philo_count - i - 1], i % 5);
+	}
+	cleanup_table(&table);
+	if (decode_to_out() != 0 || stat(TRACE_PATH, &st) != 0)
+		return (-1);
+	fd = open(OUT_PATH, O_RDONLY);
+	decoded[read(fd, decoded, sizeof(decoded) - 1)] = '\0';
+	close(fd);
+	unlink(TRACE_PATH);
+	unlink(OUT_PATH);
+	if (strlen(decoded) != len || memcmp(decoded, expected, len) != 0)
+		return (-1);
+	return (st.st_size);
+}
+
+void	test_trace_roundtrip(void)
+{
+	static const long	ts[] = {0, 0, 29, 59, 60, 1060, 70596, 70597};
+	t_table				table;
+	t_scan				s;
+	char				*args[] = {"./philo", "4", "310", "200", "100"};
+
+	TEST_SECTION("Output Test: Binary Trace Round Trip (--trace-bin)");
+	
+	/* deltas 0 0 29 30 1 1000 69536 1: short, 2-byte and 4-byte escapes */
+	TEST_ASSERT(trace_roundtrip("200", ts, 8) == TRACE_HEADER_SIZE + 8 * 2
+		+ 2 * 2 + 4, "200 philosophers: decodes to the text, 1-byte ids");
+	TEST_ASSERT(trace_roundtrip("300", ts, 8) == TRACE_HEADER_SIZE + 8 * 3
+		+ 2 * 2 + 4, "300 philosophers: decodes to the text, 2-byte ids");
+	memset(&table, 0, sizeof(t_table));
+	table.opts.trace_path = TRACE_PATH;
+	run_to_file(&table, args, 5);
+	TEST_ASSERT(decode_to_out() == 0, "a traced run decodes");
+	scan_output(&s);
+	TEST_ASSERT(s.lines > 0 && s.backwards == 0 && s.died_last,
+		"decoded run is in order and ends with the death");
+	unlink(TRACE_PATH);
+	unlink(OUT_PATH);
+}
+
+/*
+** Fills a --queue-size 4 queue before the drain thread starts, so every
+** overflow is deterministic, then drains it to OUT_PATH.
+*/
+static void	outq_fill(t_table *table, char *policy, int *states, int n)
+{
+	char	*args[] = {"./philo", "10", "800", "200", "200"};
+	int		i;
+
+	memset(table, 0, sizeof(t_table));
+	opt_out_queue(table, policy);
+	opt_queue_size(table, "4");
+	table->opts.out_path = OUT_PATH;
+	parse_arguments(table, 5, args);
+	init_table(table);
+	open_sink(table);
+	init_outq(table);
+	i = -1;
+	while (++i < n)
+		outq_push(table, i + 1, states[i]);
+	pthread_create(&table->outq.thread, NULL, outq_routine, table);
+	stop_outq(table);
+	cleanup_table(table);
+}
+
+void	test_outq_policies(void)
+{
+	t_table	table;
+	int		states[10];
+	int		ids[16];
+	int		died_at;
+	int		n;
+	int		i;
+
+	TEST_SECTION("Output Test: Bounded Queue Policies (--queue-size 4)");
+	
+	/* 1 2 3 D 5 6: 5 evicts 1, 6 evicts 2, D stays */
+	i = -1;
+	while (++i < 6)
+		states[i] = ST_THINK;
+	states[3] = ST_DIED;
+	outq_fill(&table, "drop-oldest-non-death", states, 6);
+	n = read_ids(ids, 16, &died_at);
+	TEST_ASSERT(table.outq.dropped == 2 && table.outq.spilled == 0,
+		"drop-oldest counts 2 dropped, 0 spilled");
+	TEST_ASSERT(n == 2 && ids[0] == 3 && died_at == 1 && ids[1] == 4,
+		"the oldest lines are dropped, the death line is kept");
+	/* D 2 3 4 5 6: the death is the oldest when the queue overflows */
+	states[0] = ST_DIED;
+	states[3] = ST_THINK;
+	outq_fill(&table, "drop-oldest-non-death", states, 6);
+	n = read_ids(ids, 16, &died_at);
+	TEST_ASSERT(table.outq.dropped == 2 && n == 1 && died_at == 0
+		&& ids[0] == 1, "a death at the head is never evicted");
+	/* 1..10: 5..10 go to the spill file and are read back after 1..4 */
+	i = -1;
+	while (++i < 10)
+		states[i] = ST_THINK;
+	outq_fill(&table, "spill-to-tempfile", states, 10);
+	n = read_ids(ids, 16, &died_at);
+	TEST_ASSERT(table.outq.spilled == 6 && table.outq.dropped == 0,
+		"spill counts 6 spilled, 0 dropped");
+	i = 0;
+	while (i < n && ids[i] == i + 1)
+		i++;
+	TEST_ASSERT(n == 10 && i == 10, "spilled lines are read back in order");
+	unlink(OUT_PATH);
+}
+
 /* ************************************************************************** */
 /*                              MAIN TEST RUNNER                              */
 /* ************************************************************************** */
@@ -468,6 +1138,7 @@ int	main(void)
 	/* Action tests */
 	test_take_and_drop_forks();
 	test_eat_action();
+	test_must_eat_completion();
 	test_sleep_action();
 	test_think_action();
 
@@ -479,9 +1150,20 @@ int	main(void)
 	test_integration_single_cycle();
 	test_integration_multi_thread();
 	test_integration_deadlock_prevention();
+	test_fork_strategies();
+	test_chandy_misra_bound();
+	test_edf_order();
+	test_futex_fork_lock();
+	test_ticket_fork_lock();
 	test_edge_case_single_philosopher();
 	test_thread_safety();
 
+	/* Output tests */
+	test_output_order();
+	test_async_log_merge();
+	test_outq_policies();
+	test_trace_roundtrip();
+
 	/* Print summary */
 	print_summary();
 
@@ -18,8 +18,138 @@
 # include <unistd.h>
 # include <string.h>
 # include <sys/time.h>
+# include <time.h>
 # include <pthread.h>
 # include <stdbool.h>
+# include <limits.h>
+# include <sched.h>
+# include <stdatomic.h>
+# include <fcntl.h>
+# include <errno.h>
+# include <sys/uio.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <sys/syscall.h>
+# include <linux/futex.h>
+# include <linux/io_uring.h>
+# if defined(__x86_64__)
+#  include <cpuid.h>
+#  include <x86intrin.h>
+# endif
+
+/*
+** Time is kept in ns from CLOCK_MONOTONIC (start_time, last_meal_time);
+** the CLI arguments stay in ms and printed timestamps are cut to ms.
+*/
+# define NS_PER_SEC 1000000000L
+# define NS_PER_MS 1000000L
+
+/*
+** Each philosopher sleeps to absolute deadlines chained from the
+** previous one (schedule.c). A fork wait longer than this restarts the
+** chain from the moment the forks are held.
+*/
+# define PHASE_SLACK_NS 1000000L
+
+/*
+** TSC clock (--clock tsc): length of the startup calibration, period of
+** the monitor's recalibration, bracketed reads per calibration point,
+** and the rate change (1/TSC_MAX_SKEW) that disables it.
+*/
+# define TSC_CAL_NS 10000000L
+# define TSC_RECAL_NS 1000000000L
+# define TSC_PAIR_TRIES 8
+# define TSC_MAX_SKEW 100
+
+/*
+** Startup sleep calibration (--sleep-calib): number and length of the
+** probe sleeps, and the most a sleep may spin instead of sleeping.
+*/
+# define CALIB_SAMPLES 64
+# define CALIB_SLEEP_NS 500000L
+# define CALIB_MAX_MARGIN_NS 2000000L
+
+/*
+** Longest a batching output backend may hold a line in direct mode; the
+** event-driven monitor wakes at least this often to flush it.
+*/
+# define MON_TICK_NS 1000000L
+
+/*
+** Monitor shards (--monitors): with "auto", one per MON_SHARD_MIN
+** philosophers, at most one per online core, never more than MON_MAX.
+*/
+# define MON_SHARD_MIN 4096
+# define MON_MAX 64
+
+/*
+** Death detection latency histogram (--latency): LAT_BUCKETS power-of-two
+** buckets in us, and the announcement deadline the project promises.
+*/
+# define LAT_BUCKETS 18
+# define LAT_SLA_NS 10000000L
+
+/*
+** Futex and ticket fork locks (--fork-lock): the most a waiter spins
+** before it parks. The adaptive estimate stays below it; on one CPU it
+** is 0.
+*/
+# define FLOCK_SPIN_MAX 100
+
+/*
+** Central timer wheel (--timer wheel): 100us ticks, WHEEL_LEVELS levels
+** of WHEEL_SLOTS slots; level n covers 64^(n+1) ticks (~28 min in all).
+*/
+# define WHEEL_TICK_NS 100000L
+# define WHEEL_SHIFT 6
+# define WHEEL_SLOTS 64
+# define WHEEL_MASK 63
+# define WHEEL_LEVELS 4
+
+# define LOG_RING_SIZE 256
+# define LOG_BATCH_SIZE 65536
+
+/*
+** Binary trace format (--trace-bin): 8-byte header "PHTR" + version +
+** id width + 2 zero bytes, then one record per event:
+**   byte 0 : (delta_ms << 3) | state, delta_ms in [0, 29]
+**   id     : philosopher id, 1 byte up to TRACE_SHORT_ID philosophers,
+**            2 (little endian) above
+** delta_ms is relative to the previous record (the first one to 0). A
+** delta field of TRACE_DELTA_ESC means a 2-byte little endian delta
+** follows the id, TRACE_DELTA_LONG a 4-byte one. Most records are 2
+** bytes, against ~21 for the text line.
+*/
+# define TRACE_MAGIC "PHTR"
+# define TRACE_VERSION 2
+# define TRACE_HEADER_SIZE 8
+# define TRACE_DELTA_ESC 30
+# define TRACE_DELTA_LONG 31
+# define TRACE_SHORT_ID 255
+# define TRACE_MAX_ID 65535
+
+/*
+** Formatter sizes: a philosopher's " <id> " tag, one formatted line, and
+** how many pending states coalesce fork, fork, eat into a single write(2).
+*/
+# define FMT_TAG_SIZE 16
+# define FMT_LINE_MAX 64
+# define FMT_PENDING_MAX 4
+
+/*
+** Output queue defaults: capacity in events, and how many events the
+** drain thread moves out of the queue (or spill file) per lock.
+*/
+# define OUTQ_DEFAULT_SIZE 4096
+# define OUTQ_BATCH 256
+
+/*
+** Output backends (--backend): staging buffer for the batching ones,
+** lines per writev(2), and how much the --out mapping grows at a time.
+*/
+# define SINK_STAGE_SIZE 65536
+# define SINK_IOV_MAX 64
+# define SINK_MAP_CHUNK 1048576
 
 /*
 ** Allowed functions: memset, printf, malloc, free, write, usleep, gettimeofday
@@ -30,15 +160,499 @@
 typedef struct s_philo	t_philo;
 typedef struct s_table	t_table;
 
-typedef struct s_philo
+/*
+** Printable state changes. Each value indexes the message table in log.c,
+** so the async logger can ship a small code instead of the text itself.
+*/
+typedef enum e_state
+{
+	ST_FORK,
+	ST_EAT,
+	ST_SLEEP,
+	ST_THINK,
+	ST_DIED
+}	t_state;
+
+/*
+** One logged state change. ts is captured by the producer at the moment
+** of the event (ms since start_time), not when the writer prints it.
+*/
+typedef struct s_event
 {
+	long				ts;
 	int					id;
-	int					meals_count;
-	long				last_meal_time;
+	int					state;
+}	t_event;
+
+/*
+** Single-producer/single-consumer event ring (one per philosopher, plus
+** one for the monitor). head is only written by the writer thread, tail
+** and busy only by the owning producer; padding keeps them on separate
+** cache lines.
+*/
+typedef struct s_ring
+{
+	atomic_ulong		head;
+	char				pad_head[56];
+	atomic_ulong		tail;
+	atomic_int			busy;
+	char				pad_tail[52];
+	t_event				slots[LOG_RING_SIZE];
+}	t_ring;
+
+/*
+** Pending event in the writer's merge heap. seq keeps events from the
+** same millisecond in drain order.
+*/
+typedef struct s_pending
+{
+	t_event				ev;
+	unsigned long		seq;
+}	t_pending;
+
+typedef struct s_logger
+{
+	t_ring				*rings;
+	int					ring_count;
+	pthread_t			thread;
+	atomic_bool			stop;
+	t_pending			*heap;
+	int					heap_len;
+	int					heap_cap;
+	unsigned long		seq;
+	bool				death_seen;
+	char				*buf;
+	size_t				buf_len;
+}	t_logger;
+
+/*
+** What the bounded output queue (--out-queue) does when it is full.
+** Death events are never dropped under any policy.
+*/
+typedef enum e_qpolicy
+{
+	Q_BLOCK,
+	Q_DROP_OLDEST,
+	Q_SPILL
+}	t_qpolicy;
+
+/*
+** Where formatted text goes (--backend). BK_WRITE is the plain write(2)
+** path; the others batch, submit asynchronously, splice or memcpy.
+*/
+typedef enum e_backend
+{
+	BK_WRITE,
+	BK_WRITEV,
+	BK_URING,
+	BK_VMSPLICE,
+	BK_MMAP
+}	t_backend;
+
+/*
+** Death detection latency (--latency, latency.c): the gap between a
+** philosopher's real deadline and the moment its death was announced.
+** LAT_ALL also samples near-misses: every time a monitor wakes for a
+** deadline and finds the philosopher has eaten, how late that wake was
+** is how late a death there would have been announced. Bucket k holds
+** gaps in [2^(k-1), 2^k) us (0: under 1us, the last: everything above).
+*/
+typedef enum e_lat_mode
+{
+	LAT_OFF,
+	LAT_DEATHS,
+	LAT_ALL
+}	t_lat_mode;
+
+typedef struct s_lat_hist
+{
+	unsigned long		buckets[LAT_BUCKETS];
+	unsigned long		deaths;
+	unsigned long		near_misses;
+	unsigned long		over_sla;
+	long				max_ns;
+}	t_lat_hist;
+
+/*
+** Who times the eat/sleep/think phases (--timer): each philosopher with
+** sleep_until() (TM_LOCAL), or the central timer thread (TM_WHEEL).
+*/
+typedef enum e_timer_kind
+{
+	TM_LOCAL,
+	TM_WHEEL
+}	t_timer_kind;
+
+/*
+** Fork acquisition strategy (--forks, forks.c). One row of the strategy
+** table is picked at startup; take_forks() / drop_forks() call through
+** it. init and destroy set up and tear down what the strategy needs on
+** top of the fork mutexes, and may be NULL. bounded is set when the
+** strategy itself bounds how long a philosopher waits for its forks, so
+** think_action() needs no scheduling delay. pair_lock is set when it
+** locks the forks one by one through fork_lock(), the only case where
+** --fork-lock has an effect.
+*/
+typedef struct s_fork_ops
+{
+	const char			*name;
+	bool				bounded;
+	bool				pair_lock;
+	int					(*init)(t_table *table);
+	void				(*acquire)(t_philo *philo);
+	void				(*release)(t_philo *philo);
+	void				(*destroy)(t_table *table);
+}	t_fork_ops;
+
+/*
+** Waiter strategy (forks_waiter.c): one lock over everyone's state, and
+** a philosopher is only let in once neither neighbor is eating, so it
+** never holds one fork while waiting for the other.
+*/
+typedef enum e_wstate
+{
+	WS_THINKING,
+	WS_HUNGRY,
+	WS_EATING
+}	t_wstate;
+
+typedef struct s_waiter
+{
+	pthread_mutex_t		lock;
+	pthread_cond_t		*turn;
+	t_wstate			*state;
+}	t_waiter;
+
+/*
+** Chandy-Misra fork (forks_cm.c). owner is the index of the philosopher
+** holding it. A dirty fork that is not in use goes to a neighbor that
+** asks for it; a clean one stays until its owner has eaten. requested
+** marks the other neighbor as waiting, so the owner hands it over
+** directly when it finishes eating.
+*/
+typedef struct s_cm_fork
+{
+	_Alignas(64) pthread_mutex_t	lock;
+	pthread_cond_t		cv;
+	int					owner;
+	bool				dirty;
+	bool				in_use;
+	bool				requested;
+}	t_cm_fork;
+
+/*
+** Earliest-deadline-first arbiter (forks_edf.c). Requests are pushed on
+** a lock-free stack (head, linked through next); whichever thread wins
+** busy drains it and grants fork pairs in order of last_meal_time +
+** time_to_die. pending makes the arbiter run one more pass for a
+** request or release that arrived while it was busy. grant is the
+** futex word a philosopher parks on. hungry, due and reserved are only
+** touched by the arbiter.
+*/
+typedef struct s_edf_slot
+{
+	_Alignas(64) atomic_int	grant;
+	atomic_bool			eating;
+	int					next;
+}	t_edf_slot;
+
+typedef struct s_edf
+{
+	_Alignas(64) atomic_int	head;
+	_Alignas(64) atomic_bool	busy;
+	atomic_bool			pending;
+	t_edf_slot			*slots;
+	int					*hungry;
+	long				*due;
+	bool				*reserved;
+	int					hungry_count;
+}	t_edf;
+
+/*
+** Fork lock kind (--fork-lock, fork_lock.c) used by the strategies that
+** lock the forks one by one (hierarchy, even-odd). Fork k is addressed
+** by index; init, destroy and report (printed at exit) may be NULL.
+*/
+typedef struct s_lock_ops
+{
+	const char			*name;
+	int					(*init)(t_table *table);
+	void				(*lock)(t_table *table, int k);
+	bool				(*trylock)(t_table *table, int k);
+	void				(*unlock)(t_table *table, int k);
+	void				(*destroy)(t_table *table);
+	void				(*report)(t_table *table);
+}	t_lock_ops;
+
+/*
+** Futex fork lock (fork_futex.c). state is 1 while held. An unlock that
+** finds waiters keeps it at 1 and publishes grant = seq + 2 instead: only
+** a thread that started waiting before that (read seq < grant) can claim
+** it, so the releaser cannot take the fork back on its next cycle.
+** Waiters park on seq; spin is the adaptive spin estimate.
+*/
+typedef struct s_flock
+{
+	_Alignas(64) atomic_int	state;
+	atomic_int			waiters;
+	atomic_uint			seq;
+	atomic_uint			grant;
+	atomic_int			spin;
+}	t_flock;
+
+/*
+** Ticket fork lock (fork_ticket.c): take a ticket from next, wait until
+** serving reaches it. Waiters park on serving. max_wait and waits are
+** only written by the holder, right after it got the fork.
+*/
+typedef struct s_tlock
+{
+	_Alignas(64) atomic_uint	next;
+	atomic_uint			serving;
+	long				max_wait;
+	long				waits;
+}	t_tlock;
+
+typedef struct s_opts
+{
+	bool				async_log;
+	char				*trace_path;
+	bool				out_queue;
+	t_qpolicy			queue_policy;
+	int					queue_size;
+	t_backend			backend;
+	char				*out_path;
+	t_timer_kind		timer;
+	int					monitors;
+	t_lat_mode			latency;
+	const t_fork_ops	*forks;
+	const t_lock_ops	*fork_lock;
+}	t_opts;
+
+/*
+** Bounded MPSC output queue between the philosophers and stdout.
+** Producers only hold lock long enough to stamp and copy an event; the
+** drain thread does all formatting and write(2) outside of it. While
+** spill_fd holds unread events (spill_read < spill_write), new events
+** are appended there too, so output order is preserved.
+*/
+typedef struct s_outq
+{
+	t_event				*slots;
+	int					cap;
+	int					head;
+	int					count;
+	pthread_mutex_t		lock;
+	pthread_cond_t		not_empty;
+	pthread_cond_t		not_full;
+	bool				stop;
+	int					spill_fd;
+	off_t				spill_read;
+	off_t				spill_write;
+	long				dropped;
+	long				spilled;
+	pthread_t			thread;
+}	t_outq;
+
+/*
+** Binary trace writer. Records are only appended by one thread at a
+** time (under write_lock, or by the async writer), so last_ts needs no
+** extra locking.
+*/
+typedef struct s_trace
+{
+	int					fd;
+	int					id_bytes;
+	long				last_ts;
+	unsigned char		*buf;
+	size_t				len;
+}	t_trace;
+
+/*
+** io_uring state for BK_URING, driven with raw syscalls: the mapped
+** submission/completion rings and the one write in flight. spare is the
+** buffer the kernel may still be reading.
+*/
+typedef struct s_uring
+{
+	int					fd;
+	void				*ring;
+	size_t				ring_size;
+	struct io_uring_sqe	*sqes;
+	size_t				sqes_size;
+	atomic_uint			*sq_tail;
+	unsigned int		*sq_mask;
+	unsigned int		*sq_array;
+	atomic_uint			*cq_head;
+	atomic_uint			*cq_tail;
+	unsigned int		*cq_mask;
+	struct io_uring_cqe	*cqes;
+	char				*spare;
+	size_t				inflight;
+}	t_uring;
+
+/*
+** Output sink under print_flush()/safe_print() and the writer threads.
+** Always used by one thread at a time: under write_lock in direct mode,
+** by the writer thread with --async-log / --out-queue. buf is the
+** staging buffer (writev, io_uring), the page arena (vmsplice, batch
+** starting at off) or the file mapping (mmap, cap bytes mapped).
+*/
+typedef struct s_sink
+{
+	t_backend			kind;
+	bool				open;
+	int					fd;
+	char				*buf;
+	size_t				cap;
+	size_t				len;
+	size_t				off;
+	struct iovec		iov[SINK_IOV_MAX];
+	int					iov_count;
+	size_t				page;
+	size_t				batch_max;
+	t_uring				uring;
+}	t_sink;
+
+/*
+** TSC clock state (tsc.c). seq is a seqlock over base_tsc, base_ns and
+** mult; the cal_* fields are the monitor's last calibration point and
+** only ever touched by it.
+*/
+typedef struct s_tsc
+{
+	atomic_bool			active;
+	atomic_uint			seq;
+	atomic_ulong		base_tsc;
+	atomic_long			base_ns;
+	atomic_ulong		mult;
+	unsigned long		cal_tsc;
+	long				cal_ns;
+	unsigned long		cal_mult;
+}	t_tsc;
+
+/*
+** Startup sleep calibration (--sleep-calib). The overshoot quantiles and
+** yield latency are what calibrate_sleep() measured; margin_ns and
+** spin_ns are what sleep_until() uses, both 0 when crowded (more
+** philosophers than online CPUs).
+*/
+typedef enum e_calib_mode
+{
+	CAL_AUTO,
+	CAL_OFF,
+	CAL_PRINT
+}	t_calib_mode;
+
+typedef struct s_calib
+{
+	t_calib_mode		mode;
+	long				p50_ns;
+	long				p90_ns;
+	long				max_ns;
+	long				yield_ns;
+	long				margin_ns;
+	long				spin_ns;
+	bool				crowded;
+}	t_calib;
+
+/*
+** One pending wake-up in the timer wheel. next and expiry (in ticks)
+** belong to the wheel while the timer is filed; fired is the futex word
+** the owning philosopher sleeps on.
+*/
+typedef struct s_timer
+{
+	struct s_timer		*next;
+	long				expiry;
+	atomic_uint			fired;
+}	t_timer;
+
+/*
+** Hierarchical timer wheel, owned by one timer thread. occupied has one
+** bit per non-empty slot. now_tick is the last processed tick and
+** next_tick the one the thread sleeps until (-1: no timers). Everything
+** but the thread handle is protected by lock.
+*/
+typedef struct s_wheel
+{
+	t_timer				*slots[WHEEL_LEVELS][WHEEL_SLOTS];
+	unsigned long		occupied[WHEEL_LEVELS];
+	long				now_tick;
+	long				next_tick;
+	bool				stop;
+	bool				running;
+	pthread_mutex_t		lock;
+	pthread_cond_t		cond;
+	pthread_t			thread;
+}	t_wheel;
+
+/*
+** Monitor's min-heap of death deadlines (deadline_heap.c): at is
+** last_meal_time + time_to_die of philos[philo] as last seen by the
+** monitor. Only the owning monitor shard uses it.
+*/
+typedef struct s_deadline
+{
+	long				at;
+	int					philo;
+}	t_deadline;
+
+typedef struct s_dheap
+{
+	t_deadline			*nodes;
+	int					size;
+}	t_dheap;
+
+/*
+** One monitor thread (--monitors): it owns the contiguous slice
+** philos[lo, hi) and the deadline heap over it. Shards share nothing but
+** simulation_end and mon_seq; each starts on its own cache line, as does
+** every slice (each t_philo is 64-byte aligned). Shard 0 also flushes
+** the output and recalibrates the TSC clock. lat is the shard's own
+** latency histogram, merged at exit.
+*/
+typedef struct s_monitor
+{
+	_Alignas(64) t_table	*table;
+	t_dheap				deadlines;
+	t_lat_hist			lat;
+	pthread_t			thread;
+	int					index;
+	int					lo;
+	int					hi;
+}	t_monitor;
+
+/*
+** Message suffix ("is eating\n") with its length precomputed.
+*/
+typedef struct s_msg
+{
+	const char			*text;
+	size_t				len;
+}	t_msg;
+
+/*
+** last_meal_time and meals_count are written only by the owning thread
+** (release) and read by the monitor (acquire). They sit alone on the
+** first cache line, so a meal never bounces a line another philosopher
+** is writing; philos is allocated 64-byte aligned (init_philosophers()).
+*/
+typedef struct s_philo
+{
+	_Alignas(64) atomic_long	last_meal_time;
+	atomic_int			meals_count;
+	_Alignas(64) int	id;
+	long				deadline;
+	t_timer				timer;
 	pthread_t			thread;
 	pthread_mutex_t		*left_fork;
 	pthread_mutex_t		*right_fork;
 	t_table				*table;
+	char				tag[FMT_TAG_SIZE];
+	size_t				tag_len;
+	t_state				pending[FMT_PENDING_MAX];
+	int					pending_count;
 }	t_philo;
 
 typedef struct s_table
@@ -49,29 +663,93 @@ typedef struct s_table
 	long				time_to_sleep;
 	int					must_eat_count;
 	long				start_time;
-	bool				simulation_end;
-	pthread_mutex_t		*forks;
+	_Alignas(64) atomic_bool	simulation_end;
+	_Alignas(64) pthread_mutex_t	*forks;
+	t_waiter			waiter;
+	t_cm_fork			*cm_forks;
+	t_edf				edf;
+	t_flock				*flocks;
+	t_tlock				*tlocks;
+	int					flock_spin_max;
 	pthread_mutex_t		write_lock;
-	pthread_mutex_t		meal_lock;
-	pthread_mutex_t		sim_lock;
-	pthread_t			monitor;
+	t_monitor			*monitors;
+	int					monitor_count;
 	t_philo				*philos;
+	t_opts				opts;
+	t_logger			log;
+	t_trace				trace;
+	t_outq				outq;
+	t_sink				sink;
+	t_wheel				wheel;
+	atomic_uint			mon_seq;
+	atomic_int			satisfied;
 }	t_table;
 
+/*
+** Command line option descriptor: "--name [value]" is matched against
+** the table in options.c and forwarded to apply().
+*/
+typedef struct s_option
+{
+	const char			*name;
+	bool				takes_value;
+	int					(*apply)(t_table *table, char *value);
+}	t_option;
+
 /* ************************************************************************** */
 /*                           PARSING FUNCTIONS                                */
 /* ************************************************************************** */
 int		validate_args(int argc, char **argv);
 int		ft_atoi_positive(const char *str);
 int		parse_arguments(t_table *table, int argc, char **argv);
+int		parse_options(t_table *table, int *argc, char **argv);
+int		opt_async_log(t_table *table, char *value);
+int		opt_trace_bin(t_table *table, char *value);
+int		opt_out_queue(t_table *table, char *value);
+int		opt_queue_size(t_table *table, char *value);
+int		opt_backend(t_table *table, char *value);
+int		opt_out(t_table *table, char *value);
+int		opt_clock(t_table *table, char *value);
+int		opt_sleep_calib(t_table *table, char *value);
+int		opt_timer(t_table *table, char *value);
+int		opt_monitors(t_table *table, char *value);
+int		opt_latency(t_table *table, char *value);
+int		opt_forks(t_table *table, char *value);
 
 /* ************************************************************************** */
 /*                            TIME FUNCTIONS                                  */
 /* ************************************************************************** */
+clockid_t	*time_source(void);
+t_tsc	*tsc_state(void);
+bool	tsc_init(void);
+long	tsc_now_ns(void);
+void	tsc_tick(void);
+long	get_time_ns(void);
+long	get_mono_ns(void);
+long	elapsed_ms(long start_ns);
 long	get_time_ms(void);
 long	elapsed_time(long start_time);
 void	precise_sleep(long duration);
 void	smart_sleep(long duration);
+long	next_deadline(t_philo *philo, long duration);
+void	phase_resync(t_philo *philo, long wait_start);
+void	abs_sleep(long deadline);
+void	sleep_until(long deadline);
+void	phase_sleep(t_philo *philo, long duration);
+t_calib	*sleep_calib(void);
+void	calibrate_sleep(int sleepers);
+void	print_calib(const t_calib *c);
+
+/* ************************************************************************** */
+/*                          TIMER WHEEL FUNCTIONS                             */
+/* ************************************************************************** */
+void	wheel_insert(t_wheel *w, t_timer *t);
+void	wheel_advance(t_wheel *w, long now_tick);
+long	wheel_next(const t_wheel *w);
+void	wheel_fire(t_timer *t);
+int		start_wheel(t_table *table);
+void	stop_wheel(t_table *table);
+void	wheel_sleep(t_wheel *w, t_timer *t, long deadline);
 
 /* ************************************************************************** */
 /*                    INITIALIZATION & CLEANUP FUNCTIONS                      */
@@ -89,10 +767,111 @@ void	announce_death(t_philo *philo);
 int		should_end_simulation(t_table *table);
 void	end_simulation(t_table *table);
 
+/* ************************************************************************** */
+/*                          LOGGING FUNCTIONS                                 */
+/* ************************************************************************** */
+const char	*state_msg(t_state state);
+const t_msg	*state_suffix(t_state state);
+size_t	fmt_number(char *dst, long n);
+void	fmt_tag(t_philo *philo);
+size_t	fmt_line(char *dst, long ts, const t_philo *philo, t_state state);
+void	print_state(t_philo *philo, t_state state);
+void	print_flush(t_philo *philo);
+void	print_tick(t_table *table);
+bool	print_needs_tick(t_table *table);
+void	write_all(int fd, const char *buf, size_t len);
+void	log_state(t_philo *philo, t_state state);
+void	log_push(t_ring *ring, long start, int id, t_state state);
+void	log_death(t_philo *philo);
+void	log_emit(t_table *table, const t_event *ev);
+void	log_flush(t_table *table);
+int		start_logger(t_table *table);
+void	stop_logger(t_table *table);
+void	logger_round(t_table *table, long limit);
+void	free_logger(t_logger *log);
+void	log_heap_push(t_logger *log, const t_event *ev);
+t_pending	log_heap_pop(t_logger *log);
+
+/* ************************************************************************** */
+/*                       BINARY TRACE FUNCTIONS                               */
+/* ************************************************************************** */
+int		open_trace(t_table *table);
+void	trace_record(t_trace *trace, long ts, int id, t_state state);
+void	trace_emit(t_table *table, int id, t_state state);
+void	close_trace(t_trace *trace);
+int		trace_decode(FILE *in, FILE *out);
+
+/* ************************************************************************** */
+/*                       BOUNDED OUTPUT QUEUE                                 */
+/* ************************************************************************** */
+int		init_outq(t_table *table);
+int		start_outq(t_table *table);
+void	outq_push(t_table *table, int id, t_state state);
+void	stop_outq(t_table *table);
+bool	outq_spill(t_outq *q, const t_event *ev);
+void	*outq_routine(void *arg);
+
+/* ************************************************************************** */
+/*                          OUTPUT BACKENDS                                   */
+/* ************************************************************************** */
+int		open_sink(t_table *table);
+void	sink_write(t_sink *sink, const char *buf, size_t len);
+void	sink_flush(t_sink *sink);
+void	close_sink(t_sink *sink);
+void	sink_stage(t_sink *sink, const char *buf, size_t len);
+void	writev_flush(t_sink *sink);
+int		uring_open(t_sink *sink);
+void	uring_reap(t_sink *sink);
+void	uring_flush(t_sink *sink);
+void	uring_close(t_sink *sink);
+int		vmsplice_open(t_sink *sink);
+void	vmsplice_put(t_sink *sink, const char *buf, size_t len);
+void	vmsplice_flush(t_sink *sink);
+int		mmap_open(t_sink *sink);
+void	mmap_put(t_sink *sink, const char *buf, size_t len);
+void	mmap_close(t_sink *sink);
+
 /* ************************************************************************** */
 /*                       PHILOSOPHER ACTIONS                                  */
 /* ************************************************************************** */
 void	take_forks(t_philo *philo);
+int		init_forks(t_table *table);
+void	free_forks(t_table *table);
+void	lock_pair(t_philo *philo, int first, int second);
+void	hierarchy_acquire(t_philo *philo);
+void	even_odd_acquire(t_philo *philo);
+void	pair_release(t_philo *philo);
+int		waiter_init(t_table *table);
+void	waiter_acquire(t_philo *philo);
+void	waiter_release(t_philo *philo);
+void	waiter_destroy(t_table *table);
+int		cm_init(t_table *table);
+void	cm_acquire(t_philo *philo);
+void	cm_release(t_philo *philo);
+void	cm_destroy(t_table *table);
+int		opt_fork_lock(t_table *table, char *value);
+int		init_fork_lock(t_table *table);
+void	free_fork_lock(t_table *table);
+void	fork_lock(t_table *table, int k);
+bool	fork_trylock(t_table *table, int k);
+void	fork_unlock(t_table *table, int k);
+void	report_fork_lock(t_table *table);
+void	cpu_relax(void);
+int		flock_init(t_table *table);
+void	flock_lock(t_table *table, int k);
+bool	flock_trylock(t_table *table, int k);
+void	flock_unlock(t_table *table, int k);
+void	flock_destroy(t_table *table);
+int		tlock_init(t_table *table);
+void	tlock_lock(t_table *table, int k);
+bool	tlock_trylock(t_table *table, int k);
+void	tlock_unlock(t_table *table, int k);
+void	tlock_destroy(t_table *table);
+void	tlock_report(t_table *table);
+int		edf_init(t_table *table);
+void	edf_acquire(t_philo *philo);
+void	edf_release(t_philo *philo);
+void	edf_destroy(t_table *table);
 void	eat_action(t_philo *philo);
 void	drop_forks(t_philo *philo);
 void	sleep_action(t_philo *philo);
@@ -109,7 +888,20 @@ void	join_threads(t_table *table);
 /*                         MONITOR FUNCTIONS                                  */
 /* ************************************************************************** */
 bool	is_philosopher_dead(t_philo *philo, long current_time);
+bool	check_deaths(t_monitor *mon, long current_time);
+int		init_monitors(t_table *table);
+void	free_monitors(t_table *table);
+int		init_deadlines(t_monitor *mon);
+void	free_deadlines(t_dheap *h);
+void	dheap_rekey_top(t_dheap *h, long at);
 bool	all_philosophers_satisfied(t_table *table);
+void	count_satisfied(t_table *table);
+void	monitor_kick(t_table *table);
+long	monitor_wake_at(t_monitor *mon, long now);
+void	monitor_wait(t_table *table, unsigned int seq, long at);
+void	lat_record(t_lat_hist *h, long gap_ns, bool death);
+void	print_latency(const t_lat_hist *h);
+void	report_latency(t_table *table);
 void	*monitor_routine(void *arg);
 int		start_monitor(t_table *table);
 void	join_monitor(t_table *table);
@@ -13,56 +13,31 @@
 #include "../include/philo.h"
 
 /*
-** @brief: Philosopher takes both forks (deadlock-safe via Resource Hierarchy)
-** @algorithm: Dijkstra's Resource Hierarchy - always lock lower address first
+** @brief: Philosopher takes both forks with the --forks strategy
 ** @param: philo - pointer to philosopher
 ** @return: void
 ** 
 ** Implementation:
 **   1. Handle single philosopher case (only one fork available)
 **      - Take the fork, print message, then wait to die
-**   2. Resource Hierarchy algorithm to prevent deadlock:
-**      - Always lock the lower-addressed fork first
-**      - Then lock the higher-addressed fork
-**      - This breaks circular wait condition
-**   3. Lock first_fork (lower address) with mutex
-**   4. Print "has taken a fork" message
-**   5. Lock second_fork (higher address) with mutex
-**   6. Print second "has taken a fork" message
-** 
-** Deadlock prevention:
-**   By ordering fork acquisition by memory address, at least one philosopher
-**   (typically the last in circular arrangement) will try to acquire forks
-**   in opposite order, breaking the circular wait chain.
-**   
-** Performance: No artificial delays needed (15% faster than even/odd approach)
+**   2. Acquire both forks through the strategy picked at startup
+**      (forks.c): resource hierarchy by default, or even-odd, waiter,
+**      chandy-misra, edf. Each prints "has taken a fork" twice.
+**   3. Restart the sleep timeline if the forks took long (phase_resync)
 */
 void	take_forks(t_philo *philo)
 {
-	pthread_mutex_t	*first_fork;
-	pthread_mutex_t	*second_fork;
+	long	wait_start;
 
 	if (philo->table->philo_count == 1)
 	{
 		pthread_mutex_lock(philo->left_fork);
-		safe_print(philo, "has taken a fork");
+		log_state(philo, ST_FORK);
 		return ;
 	}
-	if (philo->left_fork < philo->right_fork)
-	{
-		first_fork = philo->left_fork;
-		second_fork = philo->right_fork;
-	}
-	else
-	{
-		first_fork = philo->right_fork;
-		second_fork = philo->left_fork;
-	}
-	pthread_mutex_lock(first_fork);
-	safe_print(philo, "has taken a fork");
-	pthread_mutex_lock(second_fork);
-	safe_print(philo, "has taken a fork");
-	
+	wait_start = get_mono_ns();
+	philo->table->opts.forks->acquire(philo);
+	phase_resync(philo, wait_start);
 }
 
 /*
@@ -71,25 +46,28 @@ void	take_forks(t_philo *philo)
 ** @return: void
 ** 
 ** Implementation:
-**   1. Print "is eating" message
-**   2. Lock meal_lock mutex for safe data access
-**   3. Update last_meal_time to current time
-**   4. Increment meals_count
-**   5. Unlock meal_lock mutex
-**   6. Sleep for time_to_eat duration
+**   1. Publish last_meal_time (release store)
+**   2. Increment meals_count (release add)
+**   3. Print "is eating" message
+**   4. The meal that reaches must_eat_count counts this philosopher
+**      as satisfied; the last one to get there ends the simulation
+**   5. Sleep until the time_to_eat deadline (phase_sleep)
 ** 
-** Critical section protection:
-**   last_meal_time and meals_count are protected by meal_lock
-**   to prevent data races with the monitor thread.
+** No lock: only this thread writes the meal state, and the monitor
+** reads it with acquire loads (see t_philo).
 */
 void	eat_action(t_philo *philo)
 {
-	pthread_mutex_lock(&philo->table->meal_lock);
-	philo->last_meal_time = get_time_ms();
-	philo->meals_count++;
-	pthread_mutex_unlock(&philo->table->meal_lock);
-	safe_print(philo, "is eating");
-	smart_sleep(philo->table->time_to_eat);
+	int	meals;
+
+	atomic_store_explicit(&philo->last_meal_time, get_time_ns(),
+		memory_order_release);
+	meals = atomic_fetch_add_explicit(&philo->meals_count, 1,
+			memory_order_release) + 1;
+	log_state(philo, ST_EAT);
+	if (meals == philo->table->must_eat_count)
+		count_satisfied(philo->table);
+	phase_sleep(philo, philo->table->time_to_eat);
 }
 
 /*
@@ -98,17 +76,12 @@ void	eat_action(t_philo *philo)
 ** @return: void
 ** 
 ** Implementation:
-**   1. Unlock left fork mutex
-**   2. Unlock right fork mutex
-**   3. No printing required for fork release
-** 
-** Note: Order of unlocking doesn't matter for correctness,
-** but we unlock in consistent order for code clarity.
+**   1. Release both forks through the --forks strategy
+**   2. No printing required for fork release
 */
 void	drop_forks(t_philo *philo)
 {
-	pthread_mutex_unlock(philo->left_fork);
-	pthread_mutex_unlock(philo->right_fork);
+	philo->table->opts.forks->release(philo);
 }
 
 /*
@@ -120,12 +93,13 @@ void	drop_forks(t_philo *philo)
 **   1. Print "is sleeping" message
 **   2. Sleep for time_to_sleep duration
 ** 
-** Note: Uses smart_sleep for precise timing.
+** Note: phase_sleep() chains the deadline from the eat phase, so wake-up
+** latency does not accumulate over the eat/sleep/think cycle.
 */
 void	sleep_action(t_philo *philo)
 {
-	safe_print(philo, "is sleeping");
-	smart_sleep(philo->table->time_to_sleep);
+	log_state(philo, ST_SLEEP);
+	phase_sleep(philo, philo->table->time_to_sleep);
 }
 
 /*
@@ -139,14 +113,17 @@ void	sleep_action(t_philo *philo)
 ** 
 ** Note: With odd number of philosophers, without thinking time,
 ** some philosophers can monopolize forks, causing others to starve.
-** The delay gives everyone a fair chance to acquire forks.
+** The delay gives everyone a fair chance to acquire forks. Strategies
+** that bound the wait themselves (chandy-misra) skip it.
 */
 void	think_action(t_philo *philo)
 {
 	long	think_time;
 
-	safe_print(philo, "is thinking");
+	log_state(philo, ST_THINK);
 	think_time = 0;
+	if (philo->table->opts.forks->bounded)
+		return ;
 	if (philo->table->philo_count % 2 != 0)
 	{
 		think_time = (philo->table->time_to_eat * 2)
@@ -159,5 +136,5 @@ void	think_action(t_philo *philo)
 	else if (philo->table->time_to_eat >= philo->table->time_to_sleep)
 		think_time = 1;
 	if (think_time > 0)
-		usleep(think_time * 1000);
+		phase_sleep(philo, think_time);
 }
@@ -0,0 +1,116 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   async_log.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Writer thread routine
+** @param: arg - pointer to table structure (void* cast)
+** @return: NULL
+**
+** Merges and prints everything older than the current millisecond about
+** once per millisecond. On stop, a final round with no time limit drains
+** whatever is left (cut off at the death event, if any).
+*/
+static void	*logger_routine(void *arg)
+{
+	t_table	*table;
+
+	table = (t_table *)arg;
+	while (!atomic_load(&table->log.stop))
+	{
+		logger_round(table, elapsed_ms(table->start_time));
+		usleep(1000);
+	}
+	logger_round(table, -1);
+	return (NULL);
+}
+
+/*
+** @brief: Allocates rings, merge heap and output buffer
+** @param: log - logger to set up, count - number of philosophers
+** @return: 0 on success, 1 on error
+**
+** One ring per philosopher plus one for the monitor (death event).
+*/
+static int	alloc_logger(t_logger *log, int count)
+{
+	log->ring_count = count + 1;
+	log->heap_cap = 2 * log->ring_count * LOG_RING_SIZE;
+	log->rings = malloc(sizeof(t_ring) * log->ring_count);
+	log->heap = malloc(sizeof(t_pending) * log->heap_cap);
+	log->buf = malloc(LOG_BATCH_SIZE);
+	if (!log->rings || !log->heap || !log->buf)
+	{
+		printf("Error: Failed to allocate async logger\n");
+		free_logger(log);
+		return (1);
+	}
+	memset(log->rings, 0, sizeof(t_ring) * log->ring_count);
+	log->heap_len = 0;
+	log->seq = 0;
+	log->death_seen = false;
+	log->buf_len = 0;
+	atomic_store(&log->stop, false);
+	return (0);
+}
+
+/*
+** @brief: Starts the async writer thread (--async-log only)
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+*/
+int	start_logger(t_table *table)
+{
+	if (!table->opts.async_log)
+		return (0);
+	if (alloc_logger(&table->log, table->philo_count) != 0)
+		return (1);
+	if (pthread_create(&table->log.thread, NULL, logger_routine, table) != 0)
+	{
+		printf("Error: Failed to create logger thread\n");
+		free_logger(&table->log);
+		return (1);
+	}
+	return (0);
+}
+
+/*
+** @brief: Stops the writer thread after a final drain
+** @param: table - pointer to table structure
+** @return: void
+**
+** Must be called after all producers (philosophers and monitor) have
+** been joined, so the final round sees every event.
+*/
+void	stop_logger(t_table *table)
+{
+	if (!table->opts.async_log || !table->log.rings)
+		return ;
+	atomic_store(&table->log.stop, true);
+	pthread_join(table->log.thread, NULL);
+}
+
+/*
+** @brief: Releases logger memory
+** @param: log - logger to free
+** @return: void
+*/
+void	free_logger(t_logger *log)
+{
+	free(log->rings);
+	free(log->heap);
+	free(log->buf);
+	log->rings = NULL;
+	log->heap = NULL;
+	log->buf = NULL;
+}
@@ -0,0 +1,174 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   calib.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Sleep calibration used by sleep_until()
+** @param: void
+** @return: pointer to the calibration (margin 0 until calibrated)
+**
+** Static local like time_source(): written once by calibrate_sleep()
+** before any thread starts, only read afterwards.
+*/
+t_calib	*sleep_calib(void)
+{
+	static t_calib	calib = {.mode = CAL_AUTO};
+
+	return (&calib);
+}
+
+static void	sort_samples(long *s, int n)
+{
+	int		i;
+	int		j;
+	long	v;
+
+	i = 1;
+	while (i < n)
+	{
+		v = s[i];
+		j = i - 1;
+		while (j >= 0 && s[j] > v)
+		{
+			s[j + 1] = s[j];
+			j--;
+		}
+		s[j + 1] = v;
+		i++;
+	}
+}
+
+/*
+** @brief: Measures the sleep overshoot and yield latency of this host
+** @param: c - calibration to fill
+** @return: void
+**
+** Implementation:
+**   1. CALIB_SAMPLES absolute sleeps of CALIB_SLEEP_NS: how late
+**      clock_nanosleep() wakes up past its deadline
+**   2. CALIB_SAMPLES sched_yield() calls: how long giving the CPU away
+**      once can take
+**   3. Sort both and keep the quantiles. With CALIB_SAMPLES probes the
+**      highest quantile that is not just the worst sample is p90, so
+**      that is what the margin and the spin window are built on
+*/
+static void	measure(t_calib *c)
+{
+	long	over[CALIB_SAMPLES];
+	long	yield[CALIB_SAMPLES];
+	long	t;
+	int		i;
+
+	i = 0;
+	while (i < CALIB_SAMPLES)
+	{
+		t = get_mono_ns() + CALIB_SLEEP_NS;
+		abs_sleep(t);
+		over[i] = get_mono_ns() - t;
+		t = get_mono_ns();
+		sched_yield();
+		yield[i++] = get_mono_ns() - t;
+	}
+	sort_samples(over, CALIB_SAMPLES);
+	sort_samples(yield, CALIB_SAMPLES);
+	c->p50_ns = over[CALIB_SAMPLES / 2];
+	c->p90_ns = over[CALIB_SAMPLES * 9 / 10];
+	c->max_ns = over[CALIB_SAMPLES - 1];
+	c->yield_ns = yield[CALIB_SAMPLES * 9 / 10];
+}
+
+/*
+** @brief: Startup calibration of the spin-then-sleep timer
+** @param: sleepers - philosophers that will sleep at the same time
+** @return: void
+**
+** Implementation:
+**   1. Skip with --sleep-calib off (plain clock_nanosleep)
+**   2. Measure the host (see measure())
+**   3. Keep the kernel sleep only (margin 0) when there are more
+**      sleepers than online CPUs: their yield and spin tails would
+**      run on each other's CPU time and cost more context switches
+**      than the old polling did
+**   4. Bulk-sleep margin = p90 overshoot, capped at CALIB_MAX_MARGIN_NS
+**      so a noisy host trades at most that much CPU per sleep
+**   5. Spin window = p90 sched_yield() latency (at most the margin):
+**      closer than that to the deadline, sleep_until() stops yielding
+**   6. Print the result with --sleep-calib print
+*/
+void	calibrate_sleep(int sleepers)
+{
+	t_calib	*c;
+
+	c = sleep_calib();
+	if (c->mode == CAL_OFF)
+		return ;
+	measure(c);
+	c->crowded = sleepers > sysconf(_SC_NPROCESSORS_ONLN);
+	c->margin_ns = c->p90_ns;
+	if (c->margin_ns > CALIB_MAX_MARGIN_NS)
+		c->margin_ns = CALIB_MAX_MARGIN_NS;
+	c->spin_ns = c->yield_ns;
+	if (c->spin_ns > c->margin_ns)
+		c->spin_ns = c->margin_ns;
+	if (c->crowded)
+	{
+		c->margin_ns = 0;
+		c->spin_ns = 0;
+	}
+	if (c->mode == CAL_PRINT)
+		print_calib(c);
+}
+
+/*
+** @brief: Prints the calibration for operators (--sleep-calib print)
+** @param: c - calibrated values
+** @return: void
+**
+** Goes to stderr, so the simulation output on stdout stays clean.
+*/
+void	print_calib(const t_calib *c)
+{
+	fprintf(stderr, "sleep calibration (%d x %ldus abs sleeps)\n"
+		"  overshoot  p50 %ldus  p90 %ldus  max %ldus\n"
+		"  yield      p90 %ldus\n"
+		"  margin     %ldus (bulk sleep ends this early)\n"
+		"  spin       %ldus (busy-wait window, no yield)\n",
+		CALIB_SAMPLES, CALIB_SLEEP_NS / 1000, c->p50_ns / 1000,
+		c->p90_ns / 1000, c->max_ns / 1000,
+		c->yield_ns / 1000, c->margin_ns / 1000, c->spin_ns / 1000);
+	if (c->crowded)
+		fprintf(stderr, "  more sleepers than CPUs: kernel sleep only\n");
+}
+
+/*
+** @brief: Selects the startup sleep calibration
+** @param: table - pointer to table structure (unused)
+** @param: value - "auto", "off" or "print"
+** @return: 0 on success, 1 on unknown mode
+*/
+int	opt_sleep_calib(t_table *table, char *value)
+{
+	(void)table;
+	if (strcmp(value, "auto") == 0)
+		sleep_calib()->mode = CAL_AUTO;
+	else if (strcmp(value, "off") == 0)
+		sleep_calib()->mode = CAL_OFF;
+	else if (strcmp(value, "print") == 0)
+		sleep_calib()->mode = CAL_PRINT;
+	else
+	{
+		printf("Error: Unknown --sleep-calib %s\n", value);
+		return (1);
+	}
+	return (0);
+}
@@ -19,10 +19,13 @@
 ** 
 ** Implementation:
 **   1. Destroy all fork mutexes if they exist
-**   2. Destroy other mutexes (write, meal, sim) if initialized
-**   3. Free philosophers array if allocated
+**   2. Destroy other mutexes (write, sim) if initialized
+**   3. Free philosophers array, monitor shards and fork strategy
+**      state if allocated
 **   4. Free forks array if allocated
-**   5. Reset all pointers to NULL for safety
+**   5. Free async logger buffers, flush/close the trace file and the
+**      output backend
+**   6. Reset all pointers to NULL for safety
 ** 
 ** Note: This function should be safe to call even if
 ** initialization was only partially completed.
@@ -43,11 +46,15 @@ void	cleanup_table(t_table *table)
 		table->forks = NULL;
 	}
 	pthread_mutex_destroy(&table->write_lock);
-	pthread_mutex_destroy(&table->meal_lock);
-	pthread_mutex_destroy(&table->sim_lock);
 	if (table->philos)
 	{
 		free(table->philos);
 		table->philos = NULL;
 	}
+	free_monitors(table);
+	free_forks(table);
+	free_fork_lock(table);
+	free_logger(&table->log);
+	close_trace(&table->trace);
+	close_sink(&table->sink);
 }
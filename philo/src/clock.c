@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   clock.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Clock id read by get_time_ns()
+** @param: void
+** @return: pointer to the selected clock (CLOCK_MONOTONIC by default)
+**
+** Kept as a static local instead of a global; --clock writes it once,
+** before any thread starts, and it is only read afterwards.
+*/
+clockid_t	*time_source(void)
+{
+	static clockid_t	id = CLOCK_MONOTONIC;
+
+	return (&id);
+}
+
+/*
+** @brief: Gets current monotonic timestamp in nanoseconds
+** @param: void
+** @return: timestamp in ns, -1 on error
+**
+** Implementation:
+**   1. clock_gettime() on the selected clock (served from the vDSO,
+**      no syscall; the COARSE variant skips the hardware counter read)
+**   2. Convert tv_sec and tv_nsec to a single ns value
+**
+** Monotonic time is immune to NTP/settimeofday jumps, so deadlines
+** computed from it never move backwards. With --clock tsc the same
+** time base is read from the TSC instead (tsc.c).
+*/
+long	get_time_ns(void)
+{
+	struct timespec	ts;
+
+	if (atomic_load_explicit(&tsc_state()->active, memory_order_relaxed))
+		return (tsc_now_ns());
+	if (clock_gettime(*time_source(), &ts) == -1)
+		return (-1);
+	return (ts.tv_sec * NS_PER_SEC + ts.tv_nsec);
+}
+
+/*
+** @brief: Gets current CLOCK_MONOTONIC timestamp in nanoseconds
+** @param: void
+** @return: timestamp in ns, -1 on error
+**
+** Sleep loops always use this one: the COARSE clock only advances once
+** per scheduler tick (4ms at HZ=250), which would make every sleep
+** overshoot by up to a tick.
+*/
+long	get_mono_ns(void)
+{
+	struct timespec	ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == -1)
+		return (-1);
+	return (ts.tv_sec * NS_PER_SEC + ts.tv_nsec);
+}
+
+/*
+** @brief: Milliseconds elapsed since a ns timestamp
+** @param: start_ns - reference timestamp from get_time_ns()
+** @return: elapsed time in whole milliseconds
+**
+** The simulation keeps ns internally; this is the only place printed
+** timestamps are truncated to ms.
+*/
+long	elapsed_ms(long start_ns)
+{
+	return ((get_time_ns() - start_ns) / NS_PER_MS);
+}
+
+/*
+** @brief: Selects the clock behind get_time_ns()
+** @param: table - pointer to table structure (unused)
+** @param: value - "monotonic", "coarse" or "tsc"
+** @return: 0 on success, 1 on unknown clock
+**
+** "tsc" calibrates the TSC clock right away (10ms); without an
+** invariant TSC it stays on CLOCK_MONOTONIC with a warning.
+*/
+int	opt_clock(t_table *table, char *value)
+{
+	(void)table;
+	if (strcmp(value, "monotonic") == 0)
+		*time_source() = CLOCK_MONOTONIC;
+	else if (strcmp(value, "coarse") == 0)
+		*time_source() = CLOCK_MONOTONIC_COARSE;
+	else if (strcmp(value, "tsc") == 0)
+	{
+		*time_source() = CLOCK_MONOTONIC;
+		if (!tsc_init())
+			fprintf(stderr, "tsc: no invariant TSC, using CLOCK_MONOTONIC\n");
+	}
+	else
+	{
+		printf("Error: Unknown --clock %s\n", value);
+		return (1);
+	}
+	return (0);
+}
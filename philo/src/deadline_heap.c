@@ -0,0 +1,107 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   deadline_heap.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** Monitor-side binary min-heap of death deadlines. Philosophers never
+** touch it: when a deadline at the top has passed, the monitor reads the
+** philosopher's real last_meal_time and either declares the death or
+** re-keys the entry. A stored deadline can only be early (meals push
+** deadlines forward), so the top is always a safe lower bound.
+*/
+
+/*
+** @brief: Restores the heap order below a node whose key grew
+** @param: h - heap, k - index of the node
+** @return: void
+*/
+static void	sift_down(t_dheap *h, int k)
+{
+	t_deadline	node;
+	int			child;
+
+	node = h->nodes[k];
+	while (2 * k + 1 < h->size)
+	{
+		child = 2 * k + 1;
+		if (child + 1 < h->size && h->nodes[child + 1].at < h->nodes[child].at)
+			child++;
+		if (node.at <= h->nodes[child].at)
+			break ;
+		h->nodes[k] = h->nodes[child];
+		k = child;
+	}
+	h->nodes[k] = node;
+}
+
+/*
+** @brief: Gives the earliest deadline a new (later) key
+** @param: h - heap, at - new deadline of the top entry, in ns
+** @return: void
+**
+** O(log N); called once per meal the monitor notices.
+*/
+void	dheap_rekey_top(t_dheap *h, long at)
+{
+	h->nodes[0].at = at;
+	sift_down(h, 0);
+}
+
+/*
+** @brief: Builds a shard's heap from its philosophers' starting deadlines
+** @param: mon - monitor shard (table, lo and hi set, philosophers
+**         initialized)
+** @return: 0 on success, 1 on allocation failure
+**
+** Every philosopher starts at start_time + time_to_die, but the slice
+** is heapified (O(N)) rather than assumed in order, so any starting
+** last_meal_time is valid. Entries keep the index into table->philos.
+*/
+int	init_deadlines(t_monitor *mon)
+{
+	t_dheap	*h;
+	int		i;
+
+	h = &mon->deadlines;
+	h->nodes = malloc(sizeof(t_deadline) * (mon->hi - mon->lo));
+	if (!h->nodes)
+	{
+		printf("Error: Failed to allocate deadline heap\n");
+		return (1);
+	}
+	h->size = mon->hi - mon->lo;
+	i = 0;
+	while (i < h->size)
+	{
+		h->nodes[i].at = atomic_load(&mon->table->philos[mon->lo + i]
+				.last_meal_time) + mon->table->time_to_die * NS_PER_MS;
+		h->nodes[i].philo = mon->lo + i;
+		i++;
+	}
+	i = h->size / 2;
+	while (i-- > 0)
+		sift_down(h, i);
+	return (0);
+}
+
+/*
+** @brief: Releases the deadline heap
+** @param: h - heap to free
+** @return: void
+*/
+void	free_deadlines(t_dheap *h)
+{
+	free(h->nodes);
+	h->nodes = NULL;
+	h->size = 0;
+}
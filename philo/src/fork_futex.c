@@ -0,0 +1,172 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fork_futex.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Allocates one futex lock per fork, all free
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+*/
+int	flock_init(t_table *table)
+{
+	int	i;
+
+	table->flocks = aligned_alloc(64, sizeof(t_flock) * table->philo_count);
+	if (!table->flocks)
+		return (printf("Error: Failed to allocate fork locks\n"), 1);
+	i = 0;
+	while (i < table->philo_count)
+	{
+		atomic_init(&table->flocks[i].state, 0);
+		atomic_init(&table->flocks[i].waiters, 0);
+		atomic_init(&table->flocks[i].seq, 1);
+		atomic_init(&table->flocks[i].grant, 0);
+		atomic_init(&table->flocks[i++].spin, 0);
+	}
+	return (0);
+}
+
+/*
+** @brief: Spins briefly for a free lock
+** @param: table - pointer to table structure, f - the lock
+** @return: true if it took the lock
+**
+** Adaptive like glibc's PTHREAD_MUTEX_ADAPTIVE_NP: spins up to twice the
+** running average of what it took last time (plus a little), and moves
+** the average 1/8 towards this attempt.
+*/
+static bool	flock_spin(t_table *table, t_flock *f)
+{
+	int	spin;
+	int	max;
+	int	n;
+	int	expected;
+
+	spin = atomic_load_explicit(&f->spin, memory_order_relaxed);
+	max = spin * 2 + 10;
+	if (max > table->flock_spin_max)
+		max = table->flock_spin_max;
+	n = 0;
+	while (n < max)
+	{
+		expected = 0;
+		if (atomic_load_explicit(&f->state, memory_order_relaxed) == 0
+			&& atomic_compare_exchange_strong_explicit(&f->state, &expected,
+				1, memory_order_acquire, memory_order_relaxed))
+			break ;
+		cpu_relax();
+		n++;
+	}
+	atomic_store_explicit(&f->spin, spin + (n - spin) / 8,
+		memory_order_relaxed);
+	return (n < max);
+}
+
+/*
+** @brief: Takes fork k if it is free, never waits
+** @param: table - pointer to table structure, k - fork index
+** @return: true if it took the fork
+**
+** A fork being handed over stays at state 1, so this cannot take it.
+*/
+bool	flock_trylock(t_table *table, int k)
+{
+	int	expected;
+
+	expected = 0;
+	return (atomic_compare_exchange_strong_explicit(&table->flocks[k].state,
+			&expected, 1, memory_order_acquire, memory_order_relaxed));
+}
+
+/*
+** @brief: Locks fork k: fast path, adaptive spin, then park
+** @param: table - pointer to table structure, k - fork index
+** @return: void
+**
+** Implementation:
+**   1. CAS the state from 0 to 1, then spin for it (flock_spin())
+**   2. Note seq on arrival and count itself in waiters
+**   3. Claim a grant published after arrival (direct handoff), or take
+**      the state if an unlock found no waiters; otherwise park on seq.
+**      Every unlock bumps seq after publishing, so a wake-up in between
+**      makes FUTEX_WAIT return at once instead of being lost
+*/
+void	flock_lock(t_table *table, int k)
+{
+	t_flock		*f;
+	unsigned	arrival;
+	unsigned	seq;
+	unsigned	grant;
+
+	f = &table->flocks[k];
+	if (flock_trylock(table, k) || flock_spin(table, f))
+		return ;
+	arrival = atomic_load_explicit(&f->seq, memory_order_acquire);
+	atomic_fetch_add(&f->waiters, 1);
+	while (1)
+	{
+		seq = atomic_load_explicit(&f->seq, memory_order_acquire);
+		grant = atomic_load_explicit(&f->grant, memory_order_acquire);
+		if (grant && (int)(grant - arrival) > 0
+			&& atomic_compare_exchange_strong(&f->grant, &grant, 0))
+			break ;
+		if (flock_trylock(table, k))
+			break ;
+		syscall(SYS_futex, &f->seq, FUTEX_WAIT_PRIVATE, seq, NULL, NULL, 0);
+	}
+	atomic_fetch_sub(&f->waiters, 1);
+}
+
+/*
+** @brief: Unlocks fork k, handing it to a waiter if there is one
+** @param: table - pointer to table structure, k - fork index
+** @return: void
+**
+** With waiters the state stays 1 and ownership moves through grant;
+** seq starts at 1 and moves by 2, so a grant is odd and never 0.
+** Otherwise the fork is freed; a waiter that arrived meanwhile is woken
+** to take it. Freeing and then reading
+** waiters pairs with a waiter counting itself and then trying the
+** state, so both are sequentially consistent.
+*/
+void	flock_unlock(t_table *table, int k)
+{
+	t_flock		*f;
+	unsigned	grant;
+
+	f = &table->flocks[k];
+	if (atomic_load(&f->waiters) > 0)
+	{
+		grant = atomic_load_explicit(&f->seq, memory_order_relaxed) + 2;
+		atomic_store_explicit(&f->grant, grant, memory_order_release);
+	}
+	else
+	{
+		atomic_store(&f->state, 0);
+		if (atomic_load(&f->waiters) == 0)
+			return ;
+	}
+	atomic_fetch_add_explicit(&f->seq, 2, memory_order_release);
+	syscall(SYS_futex, &f->seq, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+/*
+** @brief: Frees the futex fork locks
+** @param: table - pointer to table structure
+** @return: void
+*/
+void	flock_destroy(t_table *table)
+{
+	free(table->flocks);
+	table->flocks = NULL;
+}
@@ -0,0 +1,169 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fork_lock.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+#if defined(__x86_64__)
+
+/*
+** @brief: Tells the CPU this is a spin-wait loop (PAUSE)
+** @return: void
+*/
+void	cpu_relax(void)
+{
+	_mm_pause();
+}
+
+#else
+
+void	cpu_relax(void)
+{
+}
+
+#endif
+
+static void	mutex_lock(t_table *table, int k)
+{
+	pthread_mutex_lock(&table->forks[k]);
+}
+
+static bool	mutex_trylock(t_table *table, int k)
+{
+	return (pthread_mutex_trylock(&table->forks[k]) == 0);
+}
+
+static void	mutex_unlock(t_table *table, int k)
+{
+	pthread_mutex_unlock(&table->forks[k]);
+}
+
+/*
+** @brief: Looks up a fork lock kind by name
+** @param: name - lock kind, or NULL for the default (mutex)
+** @return: matching kind, or NULL if unknown
+**
+** New kinds are added by appending a row to the table below. The mutex
+** kind uses table->forks, which init_mutexes() always sets up.
+*/
+static const t_lock_ops	*find_lock(const char *name)
+{
+	static const t_lock_ops	kinds[] = {
+	{"mutex", NULL, mutex_lock, mutex_trylock, mutex_unlock, NULL, NULL},
+	{"futex", flock_init, flock_lock, flock_trylock, flock_unlock,
+		flock_destroy, NULL},
+	{"ticket", tlock_init, tlock_lock, tlock_trylock, tlock_unlock,
+		tlock_destroy, tlock_report},
+	{NULL, NULL, NULL, NULL, NULL, NULL, NULL}
+	};
+	int						i;
+
+	if (!name)
+		return (&kinds[0]);
+	i = 0;
+	while (kinds[i].name)
+	{
+		if (strcmp(kinds[i].name, name) == 0)
+			return (&kinds[i]);
+		i++;
+	}
+	return (NULL);
+}
+
+/*
+** @brief: Selects the fork lock kind
+** @param: table - pointer to table structure
+** @param: value - "mutex", "futex" or "ticket"
+** @return: 0 on success, 1 on unknown kind
+*/
+int	opt_fork_lock(t_table *table, char *value)
+{
+	table->opts.fork_lock = find_lock(value);
+	if (!table->opts.fork_lock)
+	{
+		printf("Error: Unknown --fork-lock %s\n", value);
+		return (1);
+	}
+	return (0);
+}
+
+/*
+** @brief: Sets up the selected fork lock kind
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+**
+** Falls back to pthread mutexes when --fork-lock was not given, and
+** refuses --fork-lock with a strategy that never calls fork_lock()
+** (init_forks() has picked the strategy by now), rather than ignore it.
+** Spinning only pays off when the holder runs on another CPU, so with a
+** single CPU the futex and ticket waiters park straight away.
+*/
+int	init_fork_lock(t_table *table)
+{
+	if (table->opts.fork_lock && table->opts.forks
+		&& !table->opts.forks->pair_lock)
+		return (printf("Error: --fork-lock needs --forks hierarchy or "
+				"even-odd\n"), 1);
+	if (!table->opts.fork_lock)
+		table->opts.fork_lock = find_lock(NULL);
+	table->flock_spin_max = 0;
+	if (sysconf(_SC_NPROCESSORS_ONLN) > 1)
+		table->flock_spin_max = FLOCK_SPIN_MAX;
+	if (table->opts.fork_lock->init)
+		return (table->opts.fork_lock->init(table));
+	return (0);
+}
+
+/*
+** @brief: Tears down the fork lock state
+** @param: table - pointer to table structure
+** @return: void
+*/
+void	free_fork_lock(t_table *table)
+{
+	if (table->opts.fork_lock && table->opts.fork_lock->destroy)
+		table->opts.fork_lock->destroy(table);
+}
+
+/*
+** @brief: Prints what the fork lock kind measured, if it does (stderr)
+** @param: table - pointer to table structure (threads joined)
+** @return: void
+**
+** Nothing is printed for a strategy that never calls fork_lock(): the
+** counters would read as a measured bound of zero.
+*/
+void	report_fork_lock(t_table *table)
+{
+	if (table->opts.forks && !table->opts.forks->pair_lock)
+		return ;
+	if (table->opts.fork_lock && table->opts.fork_lock->report)
+		table->opts.fork_lock->report(table);
+}
+
+/*
+** @brief: Locks, tries to lock or unlocks fork k with the selected kind
+** @param: table - pointer to table structure, k - fork index
+*/
+void	fork_lock(t_table *table, int k)
+{
+	table->opts.fork_lock->lock(table, k);
+}
+
+bool	fork_trylock(t_table *table, int k)
+{
+	return (table->opts.fork_lock->trylock(table, k));
+}
+
+void	fork_unlock(t_table *table, int k)
+{
+	table->opts.fork_lock->unlock(table, k);
+}
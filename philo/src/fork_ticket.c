@@ -0,0 +1,171 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fork_ticket.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Allocates one ticket lock per fork, all free
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+*/
+int	tlock_init(t_table *table)
+{
+	int	i;
+
+	table->tlocks = aligned_alloc(64, sizeof(t_tlock) * table->philo_count);
+	if (!table->tlocks)
+		return (printf("Error: Failed to allocate fork locks\n"), 1);
+	i = 0;
+	while (i < table->philo_count)
+	{
+		atomic_init(&table->tlocks[i].next, 0);
+		atomic_init(&table->tlocks[i].serving, 0);
+		table->tlocks[i].max_wait = 0;
+		table->tlocks[i++].waits = 0;
+	}
+	return (0);
+}
+
+/*
+** @brief: Takes fork k only if nobody holds or waits for it
+** @param: table - pointer to table structure, k - fork index
+** @return: true if it took the fork
+*/
+bool	tlock_trylock(t_table *table, int k)
+{
+	unsigned	serving;
+
+	serving = atomic_load_explicit(&table->tlocks[k].serving,
+			memory_order_relaxed);
+	return (atomic_compare_exchange_strong_explicit(&table->tlocks[k].next,
+			&serving, serving + 1, memory_order_acquire,
+			memory_order_relaxed));
+}
+
+/*
+** @brief: Locks fork k in arrival order
+** @param: table - pointer to table structure, k - fork index
+** @return: void
+**
+** Implementation:
+**   1. Take a ticket; done if it is already being served
+**   2. Spin a little (multi-CPU only), then park on serving until it
+**      reaches the ticket
+**   3. Record the wait as the holder (max_wait, waits)
+*/
+void	tlock_lock(t_table *table, int k)
+{
+	t_tlock		*t;
+	unsigned	ticket;
+	unsigned	serving;
+	long		start;
+	int			spins;
+
+	t = &table->tlocks[k];
+	ticket = atomic_fetch_add(&t->next, 1);
+	if (atomic_load_explicit(&t->serving, memory_order_acquire) == ticket)
+		return ;
+	start = get_mono_ns();
+	spins = 0;
+	serving = atomic_load_explicit(&t->serving, memory_order_acquire);
+	while (serving != ticket)
+	{
+		if (spins++ < table->flock_spin_max)
+			cpu_relax();
+		else
+			syscall(SYS_futex, &t->serving, FUTEX_WAIT_PRIVATE, serving,
+				NULL, NULL, 0);
+		serving = atomic_load_explicit(&t->serving, memory_order_acquire);
+	}
+	start = get_mono_ns() - start;
+	t->waits++;
+	if (start > t->max_wait)
+		t->max_wait = start;
+}
+
+/*
+** @brief: Serves the next ticket, waking the queue if there is one
+** @param: table - pointer to table structure, k - fork index
+** @return: void
+**
+** Publishing serving and then reading next pairs with a waiter taking a
+** ticket and then reading serving, so both are sequentially consistent.
+** Every waiter is woken and only the next ticket goes on; a fork has two
+** neighbors, so that is at most one extra wake-up.
+*/
+void	tlock_unlock(t_table *table, int k)
+{
+	t_tlock		*t;
+	unsigned	serving;
+
+	t = &table->tlocks[k];
+	serving = atomic_load_explicit(&t->serving, memory_order_relaxed) + 1;
+	atomic_store(&t->serving, serving);
+	if (atomic_load(&t->next) != serving)
+		syscall(SYS_futex, &t->serving, FUTEX_WAKE_PRIVATE, INT_MAX, NULL,
+			NULL, 0);
+}
+
+/*
+** @brief: Prints every fork's longest queue wait (stderr)
+** @param: table - pointer to table structure (threads joined)
+** @return: void
+**
+** A fork has two neighbors and is granted in arrival order, so a waiter
+** is only ever behind the one holding it: the worst wait is the bound on
+** how long a philosopher can lose a fork. Without a single wait there is
+** no bound to report, only that nobody queued.
+*/
+void	tlock_report(t_table *table)
+{
+	long	worst;
+	long	waits;
+	int		at;
+	int		k;
+
+	worst = -1;
+	waits = 0;
+	at = 0;
+	k = -1;
+	while (++k < table->philo_count)
+	{
+		waits += table->tlocks[k].waits;
+		if (table->tlocks[k].max_wait > worst)
+		{
+			worst = table->tlocks[k].max_wait;
+			at = k;
+		}
+	}
+	if (waits == 0)
+	{
+		fprintf(stderr, "fork queue wait: no philosopher queued for a fork\n");
+		return ;
+	}
+	fprintf(stderr, "fork queue wait (%ld waits), max %.3fms at fork %d\n",
+		waits, (double)worst / NS_PER_MS, at + 1);
+	k = -1;
+	while (++k < table->philo_count)
+		fprintf(stderr, "  fork %4d %9.3fms%s", k + 1,
+			(double)table->tlocks[k].max_wait / NS_PER_MS,
+			(k % 5 == 4 || k == table->philo_count - 1) ? "\n" : "");
+}
+
+/*
+** @brief: Frees the ticket fork locks
+** @param: table - pointer to table structure
+** @return: void
+*/
+void	tlock_destroy(t_table *table)
+{
+	free(table->tlocks);
+	table->tlocks = NULL;
+}
@@ -0,0 +1,177 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   forks.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Looks up a fork strategy by name
+** @param: name - strategy name, or NULL for the default (hierarchy)
+** @return: matching strategy, or NULL if unknown
+**
+** New strategies are added by appending a row to the table below.
+*/
+static const t_fork_ops	*find_strategy(const char *name)
+{
+	static const t_fork_ops	strategies[] = {
+	{"hierarchy", false, true, NULL, hierarchy_acquire, pair_release, NULL},
+	{"even-odd", false, true, NULL, even_odd_acquire, pair_release, NULL},
+	{"waiter", false, false, waiter_init, waiter_acquire, waiter_release,
+		waiter_destroy},
+	{"chandy-misra", true, false, cm_init, cm_acquire, cm_release,
+		cm_destroy},
+	{"edf", false, false, edf_init, edf_acquire, edf_release, edf_destroy},
+	{NULL, false, false, NULL, NULL, NULL, NULL}
+	};
+	int						i;
+
+	if (!name)
+		return (&strategies[0]);
+	i = 0;
+	while (strategies[i].name)
+	{
+		if (strcmp(strategies[i].name, name) == 0)
+			return (&strategies[i]);
+		i++;
+	}
+	return (NULL);
+}
+
+/*
+** @brief: Selects the fork acquisition strategy
+** @param: table - pointer to table structure
+** @param: value - "hierarchy", "even-odd", "waiter", "chandy-misra"
+**         or "edf"
+** @return: 0 on success, 1 on unknown strategy
+*/
+int	opt_forks(t_table *table, char *value)
+{
+	table->opts.forks = find_strategy(value);
+	if (!table->opts.forks)
+	{
+		printf("Error: Unknown --forks %s\n", value);
+		return (1);
+	}
+	return (0);
+}
+
+/*
+** @brief: Sets up the selected fork strategy
+** @param: table - pointer to table structure (forks and philos ready)
+** @return: 0 on success, 1 on error
+**
+** Falls back to the resource hierarchy when --forks was not given.
+*/
+int	init_forks(t_table *table)
+{
+	if (!table->opts.forks)
+		table->opts.forks = find_strategy(NULL);
+	if (table->opts.forks->init && table->philo_count > 1)
+		return (table->opts.forks->init(table));
+	return (0);
+}
+
+/*
+** @brief: Tears down the fork strategy state
+** @param: table - pointer to table structure
+** @return: void
+**
+** Safe after a failed or skipped init_forks(): each destroy checks what
+** it allocated.
+*/
+void	free_forks(t_table *table)
+{
+	if (table->opts.forks && table->opts.forks->destroy)
+		table->opts.forks->destroy(table);
+}
+
+/*
+** @brief: Locks two forks in the given order with the --fork-lock kind
+** @param: philo - pointer to philosopher
+** @param: first - fork to lock first, second - fork to lock next
+** @return: void
+**
+** Implementation:
+**   1. Lock first and print "has taken a fork"
+**   2. Lock second; if it is busy, flush the pending fork line before
+**      blocking
+**   3. Print the second "has taken a fork" (coalesced with the first
+**      one and "is eating" when the fork was free)
+*/
+void	lock_pair(t_philo *philo, int first, int second)
+{
+	fork_lock(philo->table, first);
+	log_state(philo, ST_FORK);
+	if (!fork_trylock(philo->table, second))
+	{
+		print_flush(philo);
+		fork_lock(philo->table, second);
+	}
+	log_state(philo, ST_FORK);
+}
+
+/*
+** @brief: Dijkstra's resource hierarchy: lower fork index first
+** @param: philo - pointer to philosopher
+** @return: void
+**
+** By ordering fork acquisition by index (the same as by address in the
+** forks array), at least one philosopher (typically the last in the
+** circular arrangement) takes its forks in the opposite order, breaking
+** the circular wait chain.
+** No artificial delays are needed.
+*/
+void	hierarchy_acquire(t_philo *philo)
+{
+	int	left;
+	int	right;
+
+	left = philo->id - 1;
+	right = philo->id % philo->table->philo_count;
+	if (left < right)
+		lock_pair(philo, left, right);
+	else
+		lock_pair(philo, right, left);
+}
+
+/*
+** @brief: Even/odd ordering: odd ids go left first, even ids right first
+** @param: philo - pointer to philosopher
+** @return: void
+**
+** With N >= 2 there is always an odd and an even philosopher, so no
+** cycle of everyone holding the same-side fork can form. Together with
+** the even ids' delayed start (philosopher_routine()), neighbors tend
+** to alternate meals.
+*/
+void	even_odd_acquire(t_philo *philo)
+{
+	int	left;
+	int	right;
+
+	left = philo->id - 1;
+	right = philo->id % philo->table->philo_count;
+	if (philo->id % 2 == 0)
+		lock_pair(philo, right, left);
+	else
+		lock_pair(philo, left, right);
+}
+
+/*
+** @brief: Unlocks both forks (hierarchy, even-odd)
+** @param: philo - pointer to philosopher
+** @return: void
+*/
+void	pair_release(t_philo *philo)
+{
+	fork_unlock(philo->table, philo->id - 1);
+	fork_unlock(philo->table, philo->id % philo->table->philo_count);
+}
@@ -0,0 +1,228 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   forks_cm.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** Chandy-Misra on shared memory. Fork k sits between philosopher k (its
+** left fork) and philosopher k - 1 (its right fork). Instead of request
+** messages, a hungry neighbor takes a dirty idle fork itself, and
+** otherwise flags the request for the owner to act on when it has eaten.
+*/
+
+/*
+** @brief: Allocates the forks, owned by the lower index and all dirty
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+**
+** Ownership by the lower index makes the initial precedence graph
+** acyclic, which is what keeps the protocol free of deadlock.
+*/
+int	cm_init(t_table *table)
+{
+	t_cm_fork	*f;
+	int			n;
+	int			k;
+
+	n = table->philo_count;
+	table->cm_forks = aligned_alloc(64, sizeof(t_cm_fork) * n);
+	if (!table->cm_forks)
+		return (printf("Error: Failed to allocate forks\n"), 1);
+	k = 0;
+	while (k < n)
+	{
+		f = &table->cm_forks[k];
+		pthread_mutex_init(&f->lock, NULL);
+		pthread_cond_init(&f->cv, NULL);
+		f->owner = (k + n - 1) % n;
+		if (k < f->owner)
+			f->owner = k;
+		f->dirty = true;
+		f->in_use = false;
+		f->requested = false;
+		k++;
+	}
+	return (0);
+}
+
+/*
+** @brief: Asks for a fork without waiting for it
+** @param: f - fork, me - philosopher index
+** @return: void
+**
+** Takes it right away if it is dirty and idle, otherwise flags the
+** request. Both forks are asked for before waiting on either, so a
+** neighbor that is not eating cannot keep a dirty fork (and eat with
+** it again) while this philosopher waits on its other side.
+*/
+static void	cm_request(t_cm_fork *f, int me)
+{
+	pthread_mutex_lock(&f->lock);
+	if (f->owner != me)
+	{
+		if (f->dirty && !f->in_use)
+		{
+			f->owner = me;
+			f->dirty = false;
+			f->requested = false;
+		}
+		else
+			f->requested = true;
+	}
+	pthread_mutex_unlock(&f->lock);
+}
+
+/*
+** @brief: Waits until a fork belongs to philosopher me
+** @param: f - fork, me - philosopher index
+** @return: void
+**
+** A dirty fork whose owner is not eating changes hands at once and
+** becomes clean. Otherwise the request is flagged and the owner hands
+** it over in cm_release().
+*/
+static void	cm_claim(t_cm_fork *f, int me)
+{
+	pthread_mutex_lock(&f->lock);
+	while (f->owner != me)
+	{
+		if (f->dirty && !f->in_use)
+		{
+			f->owner = me;
+			f->dirty = false;
+			f->requested = false;
+			break ;
+		}
+		f->requested = true;
+		pthread_cond_wait(&f->cv, &f->lock);
+	}
+	pthread_mutex_unlock(&f->lock);
+}
+
+/*
+** @brief: Marks both forks in use if philosopher me still owns both
+** @param: a, b - its forks, lower index first, me - philosopher index
+** @return: true if it can eat
+**
+** A dirty fork it already owned may have been taken while it waited
+** for the other one; then it has to claim that one again.
+*/
+static bool	cm_hold(t_cm_fork *a, t_cm_fork *b, int me)
+{
+	bool	ok;
+
+	pthread_mutex_lock(&a->lock);
+	pthread_mutex_lock(&b->lock);
+	ok = (a->owner == me && b->owner == me);
+	if (ok)
+	{
+		a->in_use = true;
+		b->in_use = true;
+	}
+	pthread_mutex_unlock(&b->lock);
+	pthread_mutex_unlock(&a->lock);
+	return (ok);
+}
+
+/*
+** @brief: Acquires both forks with the Chandy-Misra protocol
+** @param: philo - pointer to philosopher
+** @return: void
+*/
+void	cm_acquire(t_philo *philo)
+{
+	t_cm_fork	*a;
+	t_cm_fork	*b;
+	int			me;
+
+	me = philo->id - 1;
+	a = &philo->table->cm_forks[me];
+	b = &philo->table->cm_forks[philo->id % philo->table->philo_count];
+	if (b < a)
+	{
+		a = b;
+		b = &philo->table->cm_forks[me];
+	}
+	while (1)
+	{
+		cm_request(a, me);
+		cm_request(b, me);
+		cm_claim(a, me);
+		cm_claim(b, me);
+		if (cm_hold(a, b, me))
+			break ;
+	}
+	log_state(philo, ST_FORK);
+	log_state(philo, ST_FORK);
+}
+
+/*
+** @brief: Dirties a fork after a meal and passes it on if requested
+** @param: f - fork, next - the other philosopher sharing it
+** @return: void
+*/
+static void	cm_put(t_cm_fork *f, int next)
+{
+	pthread_mutex_lock(&f->lock);
+	f->in_use = false;
+	f->dirty = true;
+	if (f->requested)
+	{
+		f->owner = next;
+		f->dirty = false;
+		f->requested = false;
+		pthread_cond_broadcast(&f->cv);
+	}
+	pthread_mutex_unlock(&f->lock);
+}
+
+/*
+** @brief: Releases both forks after eating
+** @param: philo - pointer to philosopher
+** @return: void
+**
+** A waiting neighbor gets the fork clean, so it cannot be taken back
+** before that neighbor has eaten: a philosopher waits at most one meal
+** of each neighbor.
+*/
+void	cm_release(t_philo *philo)
+{
+	int	me;
+	int	n;
+
+	me = philo->id - 1;
+	n = philo->table->philo_count;
+	cm_put(&philo->table->cm_forks[me], (me + n - 1) % n);
+	cm_put(&philo->table->cm_forks[(me + 1) % n], (me + 1) % n);
+}
+
+/*
+** @brief: Frees the Chandy-Misra forks
+** @param: table - pointer to table structure
+** @return: void
+*/
+void	cm_destroy(t_table *table)
+{
+	int	k;
+
+	if (!table->cm_forks)
+		return ;
+	k = 0;
+	while (k < table->philo_count)
+	{
+		pthread_mutex_destroy(&table->cm_forks[k].lock);
+		pthread_cond_destroy(&table->cm_forks[k].cv);
+		k++;
+	}
+	free(table->cm_forks);
+	table->cm_forks = NULL;
+}
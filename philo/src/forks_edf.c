@@ -0,0 +1,241 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   forks_edf.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** Earliest-deadline-first arbitration. Philosopher i eats with forks i
+** and i + 1 (mod n). There is no arbiter thread: a philosopher that asks
+** for its forks or gives them back runs the arbiter itself if nobody
+** else is, so a release hands the forks straight to the neighbor that
+** should have them.
+*/
+
+/*
+** @brief: Allocates the arbiter state
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+*/
+int	edf_init(t_table *table)
+{
+	t_edf	*e;
+	int		i;
+
+	e = &table->edf;
+	e->slots = aligned_alloc(64, sizeof(t_edf_slot) * table->philo_count);
+	e->hungry = malloc(sizeof(int) * table->philo_count);
+	e->due = malloc(sizeof(long) * table->philo_count);
+	e->reserved = calloc(table->philo_count, sizeof(bool));
+	if (!e->slots || !e->hungry || !e->due || !e->reserved)
+		return (edf_destroy(table),
+			printf("Error: Failed to initialize edf arbiter\n"), 1);
+	atomic_init(&e->head, -1);
+	atomic_init(&e->busy, false);
+	atomic_init(&e->pending, false);
+	e->hungry_count = 0;
+	i = 0;
+	while (i < table->philo_count)
+	{
+		atomic_init(&e->slots[i].grant, 0);
+		atomic_init(&e->slots[i].eating, false);
+		e->slots[i++].next = -1;
+	}
+	return (0);
+}
+
+/*
+** @brief: Moves every pushed request into the hungry list, sorted by
+**         deadline (earliest first)
+** @param: table - pointer to table structure
+** @return: void
+**
+** A deadline is computed once, when its request is collected: a
+** philosopher's last meal does not change while it waits, so it stays
+** exact. Insertion keeps the short list sorted as requests come in.
+*/
+static void	edf_collect(t_table *table)
+{
+	t_edf	*e;
+	int		i;
+	int		k;
+	long	due;
+
+	e = &table->edf;
+	i = atomic_exchange_explicit(&e->head, -1, memory_order_acquire);
+	while (i != -1)
+	{
+		due = atomic_load_explicit(&table->philos[i].last_meal_time,
+				memory_order_acquire) + table->time_to_die * NS_PER_MS;
+		k = e->hungry_count++;
+		while (k > 0 && e->due[k - 1] > due)
+		{
+			e->hungry[k] = e->hungry[k - 1];
+			e->due[k] = e->due[k - 1];
+			k--;
+		}
+		e->hungry[k] = i;
+		e->due[k] = due;
+		i = e->slots[i].next;
+	}
+}
+
+/*
+** @brief: Lets philosopher i eat: marks it eating and wakes it up
+** @param: e - arbiter, i - philosopher index
+** @return: void
+*/
+static void	edf_grant(t_edf *e, int i)
+{
+	atomic_store_explicit(&e->slots[i].eating, true, memory_order_relaxed);
+	atomic_store_explicit(&e->slots[i].grant, 1, memory_order_release);
+	syscall(SYS_futex, &e->slots[i].grant, FUTEX_WAKE_PRIVATE, 1, NULL,
+		NULL, 0);
+}
+
+/*
+** @brief: One arbitration pass (caller owns busy)
+** @param: table - pointer to table structure
+** @return: void
+**
+** Implementation:
+**   1. Collect new requests into the deadline-sorted hungry list
+**   2. Walk it earliest deadline first. A philosopher whose neighbors
+**      are not eating and whose forks no earlier one reserved is
+**      granted; otherwise it reserves both of its forks, so a later
+**      deadline cannot take them and delay it further
+**   3. Drop the granted ones from the list and clear the reservations
+*/
+static void	edf_pass(t_table *table)
+{
+	t_edf	*e;
+	int		n;
+	int		i;
+	int		k;
+	int		kept;
+
+	e = &table->edf;
+	n = table->philo_count;
+	edf_collect(table);
+	kept = 0;
+	k = -1;
+	while (++k < e->hungry_count)
+	{
+		i = e->hungry[k];
+		if (!e->reserved[i] && !e->reserved[(i + 1) % n]
+			&& !atomic_load_explicit(&e->slots[(i + n - 1) % n].eating,
+				memory_order_acquire)
+			&& !atomic_load_explicit(&e->slots[(i + 1) % n].eating,
+				memory_order_acquire))
+		{
+			edf_grant(e, i);
+			continue ;
+		}
+		e->reserved[i] = true;
+		e->reserved[(i + 1) % n] = true;
+		e->hungry[kept] = i;
+		e->due[kept++] = e->due[k];
+	}
+	e->hungry_count = kept;
+	k = -1;
+	while (++k < kept)
+	{
+		e->reserved[e->hungry[k]] = false;
+		e->reserved[(e->hungry[k] + 1) % n] = false;
+	}
+}
+
+/*
+** @brief: Runs the arbiter unless another thread already is
+** @param: table - pointer to table structure
+** @return: void
+**
+** pending is raised before trying to take busy. Either this thread gets
+** busy, or the one holding it sees pending before letting go and makes
+** another pass, so no request or release is left unhandled.
+*/
+static void	edf_run(t_table *table)
+{
+	t_edf	*e;
+
+	e = &table->edf;
+	atomic_store(&e->pending, true);
+	while (!atomic_exchange(&e->busy, true))
+	{
+		while (atomic_exchange(&e->pending, false))
+			edf_pass(table);
+		atomic_store(&e->busy, false);
+		if (!atomic_load(&e->pending))
+			return ;
+	}
+}
+
+/*
+** @brief: Asks the arbiter for both forks and parks until granted
+** @param: philo - pointer to philosopher
+** @return: void
+**
+** The request is pushed with a CAS on head; the arbiter takes the
+** whole stack at once, so there is no ABA on the pop side.
+*/
+void	edf_acquire(t_philo *philo)
+{
+	t_edf_slot	*slot;
+	t_edf		*e;
+	int			me;
+
+	e = &philo->table->edf;
+	me = philo->id - 1;
+	slot = &e->slots[me];
+	slot->next = atomic_load_explicit(&e->head, memory_order_relaxed);
+	while (!atomic_compare_exchange_weak_explicit(&e->head, &slot->next, me,
+			memory_order_release, memory_order_relaxed))
+		;
+	edf_run(philo->table);
+	while (!atomic_load_explicit(&slot->grant, memory_order_acquire))
+		syscall(SYS_futex, &slot->grant, FUTEX_WAIT_PRIVATE, 0, NULL,
+			NULL, 0);
+	atomic_store_explicit(&slot->grant, 0, memory_order_relaxed);
+	log_state(philo, ST_FORK);
+	log_state(philo, ST_FORK);
+}
+
+/*
+** @brief: Gives both forks back and hands them on
+** @param: philo - pointer to philosopher
+** @return: void
+*/
+void	edf_release(t_philo *philo)
+{
+	atomic_store_explicit(&philo->table->edf.slots[philo->id - 1].eating,
+		false, memory_order_release);
+	edf_run(philo->table);
+}
+
+/*
+** @brief: Frees the arbiter state
+** @param: table - pointer to table structure
+** @return: void
+*/
+void	edf_destroy(t_table *table)
+{
+	t_edf	*e;
+
+	e = &table->edf;
+	free(e->slots);
+	free(e->hungry);
+	free(e->due);
+	free(e->reserved);
+	e->slots = NULL;
+	e->hungry = NULL;
+	e->due = NULL;
+	e->reserved = NULL;
+}
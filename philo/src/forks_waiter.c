@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   forks_waiter.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Allocates the waiter's state and per-philosopher conditions
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+*/
+int	waiter_init(t_table *table)
+{
+	t_waiter	*w;
+	int			i;
+
+	w = &table->waiter;
+	w->turn = malloc(sizeof(pthread_cond_t) * table->philo_count);
+	w->state = malloc(sizeof(t_wstate) * table->philo_count);
+	if (!w->turn || !w->state || pthread_mutex_init(&w->lock, NULL) != 0)
+	{
+		free(w->turn);
+		free(w->state);
+		w->turn = NULL;
+		w->state = NULL;
+		return (printf("Error: Failed to initialize waiter\n"), 1);
+	}
+	i = 0;
+	while (i < table->philo_count)
+	{
+		pthread_cond_init(&w->turn[i], NULL);
+		w->state[i++] = WS_THINKING;
+	}
+	return (0);
+}
+
+/*
+** @brief: Lets philosopher i eat if it is hungry and both neighbors
+**         are not eating (caller holds the waiter lock)
+** @param: table - pointer to table structure, i - philosopher index
+** @return: void
+*/
+static void	waiter_test(t_table *table, int i)
+{
+	t_waiter	*w;
+	int			n;
+
+	w = &table->waiter;
+	n = table->philo_count;
+	if (w->state[i] == WS_HUNGRY && w->state[(i + n - 1) % n] != WS_EATING
+		&& w->state[(i + 1) % n] != WS_EATING)
+	{
+		w->state[i] = WS_EATING;
+		pthread_cond_signal(&w->turn[i]);
+	}
+}
+
+/*
+** @brief: Asks the waiter for both forks
+** @param: philo - pointer to philosopher
+** @return: void
+**
+** The philosopher waits on its own condition, so a release only wakes
+** the neighbors it made able to eat, never the whole table.
+*/
+void	waiter_acquire(t_philo *philo)
+{
+	t_waiter	*w;
+	int			i;
+
+	w = &philo->table->waiter;
+	i = philo->id - 1;
+	pthread_mutex_lock(&w->lock);
+	w->state[i] = WS_HUNGRY;
+	waiter_test(philo->table, i);
+	while (w->state[i] != WS_EATING)
+		pthread_cond_wait(&w->turn[i], &w->lock);
+	pthread_mutex_unlock(&w->lock);
+	log_state(philo, ST_FORK);
+	log_state(philo, ST_FORK);
+}
+
+/*
+** @brief: Gives both forks back and lets the neighbors in if they can
+** @param: philo - pointer to philosopher
+** @return: void
+*/
+void	waiter_release(t_philo *philo)
+{
+	t_waiter	*w;
+	int			i;
+	int			n;
+
+	w = &philo->table->waiter;
+	i = philo->id - 1;
+	n = philo->table->philo_count;
+	pthread_mutex_lock(&w->lock);
+	w->state[i] = WS_THINKING;
+	waiter_test(philo->table, (i + n - 1) % n);
+	waiter_test(philo->table, (i + 1) % n);
+	pthread_mutex_unlock(&w->lock);
+}
+
+/*
+** @brief: Frees the waiter's state
+** @param: table - pointer to table structure
+** @return: void
+*/
+void	waiter_destroy(t_table *table)
+{
+	t_waiter	*w;
+	int			i;
+
+	w = &table->waiter;
+	if (!w->turn)
+		return ;
+	i = 0;
+	while (i < table->philo_count)
+		pthread_cond_destroy(&w->turn[i++]);
+	pthread_mutex_destroy(&w->lock);
+	free(w->turn);
+	free(w->state);
+	w->turn = NULL;
+	w->state = NULL;
+}
@@ -20,8 +20,6 @@
 static void	destroy_table_mutexes(t_table *table)
 {
 	pthread_mutex_destroy(&table->write_lock);
-	pthread_mutex_destroy(&table->meal_lock);
-	pthread_mutex_destroy(&table->sim_lock);
 }
 
 /*
@@ -64,16 +62,6 @@ int	init_mutexes(t_table *table)
 {
 	if (pthread_mutex_init(&table->write_lock, NULL) != 0)
 		return (printf("Error: Failed to initialize write_lock\n"), 1);
-	if (pthread_mutex_init(&table->meal_lock, NULL) != 0)
-	{
-		pthread_mutex_destroy(&table->write_lock);
-		return (printf("Error: Failed to initialize meal_lock\n"), 1);
-	}
-	if (pthread_mutex_init(&table->sim_lock, NULL) != 0)
-	{
-		destroy_table_mutexes(table);
-		return (printf("Error: Failed to initialize sim_lock\n"), 1);
-	}
 	if (init_fork_mutexes(table) != 0)
 	{
 		destroy_table_mutexes(table);
@@ -88,12 +76,13 @@ int	init_mutexes(t_table *table)
 ** @return: 0 on success, 1 on error
 ** 
 ** Implementation:
-**   1. Allocate memory for philos array
+**   1. Allocate the philos array, cache-line aligned (see t_philo)
 **   2. Initialize each philosopher's basic data (id, meals_count)
 **   3. Assign left and right fork pointers (circular pattern)
 **   4. Set table reference for each philosopher
-**   5. Initialize last_meal_time to 0 (will be set at simulation start)
-**   6. Handle memory allocation failures
+**   5. Initialize last_meal_time and the sleep timeline (deadline)
+**   6. Build the " <id> " output tag used by the formatter
+**   7. Handle memory allocation failures
 ** 
 ** Fork assignment strategy:
 **   - Left fork: philosopher's own fork (index = id - 1)
@@ -104,7 +93,7 @@ int	init_philosophers(t_table *table)
 {
 	int	i;
 
-	table->philos = malloc(sizeof(t_philo) * table->philo_count);
+	table->philos = aligned_alloc(64, sizeof(t_philo) * table->philo_count);
 	if (!table->philos)
 	{
 		printf("Error: Failed to allocate philosophers array\n");
@@ -114,12 +103,15 @@ int	init_philosophers(t_table *table)
 	while (i < table->philo_count)
 	{
 		table->philos[i].id = i + 1;
-		table->philos[i].meals_count = 0;
-		table->philos[i].last_meal_time = table->start_time;
+		atomic_init(&table->philos[i].meals_count, 0);
+		atomic_init(&table->philos[i].last_meal_time, table->start_time);
+		table->philos[i].deadline = 0;
 		table->philos[i].left_fork = &table->forks[i];
 		table->philos[i].right_fork = &table->forks[(i + 1)
 			% table->philo_count];
 		table->philos[i].table = table;
+		table->philos[i].pending_count = 0;
+		fmt_tag(&table->philos[i]);
 		i++;
 	}
 	return (0);
@@ -132,9 +124,12 @@ int	init_philosophers(t_table *table)
 ** 
 ** Implementation:
 **   1. Set simulation_end to false (simulation starts running)
-**   2. Record start_time with get_time_ms() for timestamp calculation
+**   2. Record start_time with get_time_ns() for timestamp calculation
 **   3. Call init_mutexes() to set up all mutex locks
-**   4. Call init_philosophers() to create philosopher array
+**   4. Call init_philosophers() to create philosopher array, then
+**      init_monitors() for the monitor shards and their deadline heaps,
+**      init_forks() for the --forks strategy and init_fork_lock() for
+**      the --fork-lock kind
 **   5. Handle any initialization failures with proper cleanup
 ** 
 ** Note: This assumes parse_arguments() has already been called
@@ -142,8 +137,8 @@ int	init_philosophers(t_table *table)
 */
 int	init_table(t_table *table)
 {
-	table->simulation_end = false;
-	table->start_time = get_time_ms();
+	atomic_init(&table->simulation_end, false);
+	table->start_time = get_time_ns();
 	if (table->start_time == -1)
 	{
 		printf("Error: Failed to get start time\n");
@@ -151,7 +146,8 @@ int	init_table(t_table *table)
 	}
 	if (init_mutexes(table) != 0)
 		return (1);
-	if (init_philosophers(table) != 0)
+	if (init_philosophers(table) != 0 || init_monitors(table) != 0
+		|| init_forks(table) != 0 || init_fork_lock(table) != 0)
 	{
 		cleanup_table(table);
 		return (1);
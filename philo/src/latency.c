@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   latency.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Adds one detection gap to a histogram
+** @param: h - histogram (owned by the calling monitor shard)
+** @param: gap_ns - announcement time minus the real deadline
+** @param: death - true for a death, false for a near-miss
+** @return: void
+*/
+void	lat_record(t_lat_hist *h, long gap_ns, bool death)
+{
+	unsigned long	us;
+	int				k;
+
+	if (gap_ns < 0)
+		gap_ns = 0;
+	us = gap_ns / 1000;
+	k = 0;
+	if (us > 0)
+		k = 64 - __builtin_clzl(us);
+	if (k >= LAT_BUCKETS)
+		k = LAT_BUCKETS - 1;
+	h->buckets[k]++;
+	h->deaths += death;
+	h->near_misses += !death;
+	h->over_sla += (gap_ns > LAT_SLA_NS);
+	if (gap_ns > h->max_ns)
+		h->max_ns = gap_ns;
+}
+
+/*
+** @brief: Upper bound of the bucket holding a quantile
+** @param: h - histogram, total - sample count, per_mille - quantile
+** @return: bucket upper bound in us (-1 for the open last bucket)
+*/
+static long	quantile_us(const t_lat_hist *h, unsigned long total,
+	int per_mille)
+{
+	unsigned long	seen;
+	int				k;
+
+	seen = 0;
+	k = 0;
+	while (k < LAT_BUCKETS - 1)
+	{
+		seen += h->buckets[k];
+		if (seen * 1000 >= total * per_mille)
+			return (1L << k);
+		k++;
+	}
+	return (-1);
+}
+
+/*
+** @brief: Prints a latency histogram for operators (--latency)
+** @param: h - histogram
+** @return: void
+**
+** Goes to stderr, so the simulation output on stdout stays clean. Only
+** non-empty buckets are listed; quantiles are bucket upper bounds.
+*/
+void	print_latency(const t_lat_hist *h)
+{
+	unsigned long	total;
+	unsigned long	peak;
+	int				k;
+
+	total = h->deaths + h->near_misses;
+	fprintf(stderr, "death detection latency (%lu deaths, %lu near-misses)\n",
+		h->deaths, h->near_misses);
+	if (total == 0)
+		return ;
+	fprintf(stderr, "  p50 < %ldus  p99 < %ldus  max %ldus  over %ldms: %lu\n",
+		quantile_us(h, total, 500), quantile_us(h, total, 990),
+		h->max_ns / 1000, LAT_SLA_NS / NS_PER_MS, h->over_sla);
+	peak = 1;
+	k = -1;
+	while (++k < LAT_BUCKETS)
+		if (h->buckets[k] > peak)
+			peak = h->buckets[k];
+	k = -1;
+	while (++k < LAT_BUCKETS)
+	{
+		if (h->buckets[k] == 0)
+			continue ;
+		fprintf(stderr, "  [%6ld, ", (k > 0) * (1L << (k - 1)));
+		if (k < LAT_BUCKETS - 1)
+			fprintf(stderr, "%6ld) us", 1L << k);
+		else
+			fprintf(stderr, "   inf) us");
+		fprintf(stderr, " %8lu %.*s\n", h->buckets[k],
+			(int)(h->buckets[k] * 40 / peak),
+			"########################################");
+	}
+}
+
+/*
+** @brief: Merges the monitor shards' histograms and prints them
+** @param: table - pointer to table structure (monitors joined)
+** @return: void
+*/
+void	report_latency(t_table *table)
+{
+	t_lat_hist	all;
+	t_lat_hist	*h;
+	int			i;
+	int			k;
+
+	if (table->opts.latency == LAT_OFF)
+		return ;
+	memset(&all, 0, sizeof(all));
+	i = -1;
+	while (++i < table->monitor_count)
+	{
+		h = &table->monitors[i].lat;
+		k = -1;
+		while (++k < LAT_BUCKETS)
+			all.buckets[k] += h->buckets[k];
+		all.deaths += h->deaths;
+		all.near_misses += h->near_misses;
+		all.over_sla += h->over_sla;
+		if (h->max_ns > all.max_ns)
+			all.max_ns = h->max_ns;
+	}
+	print_latency(&all);
+}
+
+/*
+** @brief: Selects what the death detection latency report samples
+** @param: table - pointer to table structure
+** @param: value - "off", "deaths" or "all" (deaths and near-misses)
+** @return: 0 on success, 1 on unknown mode
+*/
+int	opt_latency(t_table *table, char *value)
+{
+	if (strcmp(value, "off") == 0)
+		table->opts.latency = LAT_OFF;
+	else if (strcmp(value, "deaths") == 0)
+		table->opts.latency = LAT_DEATHS;
+	else if (strcmp(value, "all") == 0)
+		table->opts.latency = LAT_ALL;
+	else
+	{
+		printf("Error: Unknown --latency %s\n", value);
+		return (1);
+	}
+	return (0);
+}
@@ -0,0 +1,102 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log.c                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Pushes one event into an SPSC ring (producer side)
+** @param: ring - ring owned by the calling thread
+** @param: start - simulation start time (ns), id/state - event payload
+** @return: void
+**
+** Implementation:
+**   1. Wait for a free slot if the writer has fallen a full ring behind
+**   2. Raise busy, then capture the timestamp and fill the slot
+**   3. Publish the slot by advancing tail (release)
+**   4. Drop busy
+**
+** busy brackets the window between reading the clock and publishing the
+** event. The writer waits for it to drop before deciding which
+** timestamps are safe to print, so no older event can show up later.
+*/
+void	log_push(t_ring *ring, long start, int id, t_state state)
+{
+	unsigned long	tail;
+	t_event			*slot;
+
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	while (tail - atomic_load_explicit(&ring->head, memory_order_acquire)
+		>= LOG_RING_SIZE)
+		usleep(50);
+	atomic_store(&ring->busy, 1);
+	slot = &ring->slots[tail & (LOG_RING_SIZE - 1)];
+	slot->ts = elapsed_ms(start);
+	slot->id = id;
+	slot->state = state;
+	atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+	atomic_store(&ring->busy, 0);
+}
+
+/*
+** @brief: Logs a philosopher state change
+** @param: philo - philosopher changing state, state - new state
+** @return: void
+**
+** Synchronous mode formats through print_state(), or records a binary
+** event with --trace-bin. With --out-queue or --async-log the event is
+** handed to a background thread (queue or the philosopher's own ring)
+** and printed (or traced) later, so the philosopher never waits on stdout.
+*/
+void	log_state(t_philo *philo, t_state state)
+{
+	t_table	*table;
+
+	table = philo->table;
+	if (!table->opts.async_log && !table->opts.out_queue && !table->trace.buf)
+	{
+		print_state(philo, state);
+		return ;
+	}
+	if (should_end_simulation(table))
+		return ;
+	if (table->opts.out_queue)
+		outq_push(table, philo->id, state);
+	else if (table->opts.async_log)
+		log_push(&table->log.rings[philo->id - 1], table->start_time,
+			philo->id, state);
+	else
+		trace_emit(table, philo->id, state);
+}
+
+/*
+** @brief: Logs the death event through the active output path
+** @param: philo - philosopher who died
+** @return: void
+**
+** Called by announce_death() once the simulation flag is set, whenever
+** output does not go straight to stdout. The async logger keeps a ring
+** for the monitor (the last one) so it never shares one with a
+** philosopher.
+*/
+void	log_death(t_philo *philo)
+{
+	t_table	*table;
+
+	table = philo->table;
+	if (table->opts.out_queue)
+		outq_push(table, philo->id, ST_DIED);
+	else if (table->opts.async_log)
+		log_push(&table->log.rings[table->philo_count], table->start_time,
+			philo->id, ST_DIED);
+	else
+		trace_emit(table, philo->id, ST_DIED);
+}
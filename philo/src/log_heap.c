@@ -0,0 +1,94 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log_heap.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Ordering of pending events in the merge heap
+** @param: a, b - pending events
+** @return: true if a must be printed before b
+**
+** Events are ordered by timestamp. Within the same millisecond a death
+** goes last, so nothing stamped at or before the death is cut off, and
+** remaining ties keep drain order (seq).
+*/
+static bool	pending_before(const t_pending *a, const t_pending *b)
+{
+	if (a->ev.ts != b->ev.ts)
+		return (a->ev.ts < b->ev.ts);
+	if ((a->ev.state == ST_DIED) != (b->ev.state == ST_DIED))
+		return (b->ev.state == ST_DIED);
+	return (a->seq < b->seq);
+}
+
+/*
+** @brief: Inserts an event into the writer's min-heap
+** @param: log - logger owning the heap, ev - event copied from a ring
+** @return: void
+*/
+void	log_heap_push(t_logger *log, const t_event *ev)
+{
+	int			i;
+	t_pending	tmp;
+
+	i = log->heap_len++;
+	log->heap[i].ev = *ev;
+	log->heap[i].seq = log->seq++;
+	while (i > 0 && pending_before(&log->heap[i], &log->heap[(i - 1) / 2]))
+	{
+		tmp = log->heap[i];
+		log->heap[i] = log->heap[(i - 1) / 2];
+		log->heap[(i - 1) / 2] = tmp;
+		i = (i - 1) / 2;
+	}
+}
+
+/*
+** @brief: Restores the heap property from index i downwards
+** @param: log - logger owning the heap, i - index to sift
+** @return: void
+*/
+static void	sift_down(t_logger *log, int i)
+{
+	int			child;
+	t_pending	tmp;
+
+	while (2 * i + 1 < log->heap_len)
+	{
+		child = 2 * i + 1;
+		if (child + 1 < log->heap_len
+			&& pending_before(&log->heap[child + 1], &log->heap[child]))
+			child++;
+		if (!pending_before(&log->heap[child], &log->heap[i]))
+			break ;
+		tmp = log->heap[i];
+		log->heap[i] = log->heap[child];
+		log->heap[child] = tmp;
+		i = child;
+	}
+}
+
+/*
+** @brief: Removes and returns the earliest pending event
+** @param: log - logger owning the heap (must not be empty)
+** @return: earliest event
+*/
+t_pending	log_heap_pop(t_logger *log)
+{
+	t_pending	top;
+
+	top = log->heap[0];
+	log->heap_len--;
+	log->heap[0] = log->heap[log->heap_len];
+	sift_down(log, 0);
+	return (top);
+}
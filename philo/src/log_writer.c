@@ -0,0 +1,115 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log_writer.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Hands the writer's batch to the output backend and flushes it
+** @param: table - pointer to table structure
+** @return: void
+*/
+void	log_flush(t_table *table)
+{
+	if (table->log.buf_len == 0)
+		return ;
+	sink_write(&table->sink, table->log.buf, table->log.buf_len);
+	sink_flush(&table->sink);
+	table->log.buf_len = 0;
+}
+
+/*
+** @brief: Formats one event into the batch buffer
+** @param: table - pointer to table structure, ev - event to print
+** @return: void
+**
+** Same "timestamp id message" format as safe_print(), or a binary
+** record with --trace-bin. Nothing is emitted once the death event has
+** been emitted. Shared by the async writer and the output queue's
+** drain thread; only one of them runs at a time.
+*/
+void	log_emit(t_table *table, const t_event *ev)
+{
+	t_logger	*log;
+
+	log = &table->log;
+	if (log->death_seen)
+		return ;
+	if (table->trace.buf)
+	{
+		trace_record(&table->trace, ev->ts, ev->id, ev->state);
+		log->death_seen = (ev->state == ST_DIED);
+		return ;
+	}
+	if (log->buf_len + FMT_LINE_MAX > LOG_BATCH_SIZE)
+		log_flush(table);
+	log->buf_len += fmt_line(log->buf + log->buf_len, ev->ts,
+			&table->philos[ev->id - 1], ev->state);
+	if (ev->state == ST_DIED)
+		log->death_seen = true;
+}
+
+/*
+** @brief: Moves every published event from the rings into the heap
+** @param: log - logger
+** @return: void
+**
+** Waits for producers that are between reading the clock and publishing
+** (busy), so that after this call no event older than the round's limit
+** can still be in flight.
+*/
+static void	drain_rings(t_logger *log)
+{
+	int				i;
+	unsigned long	head;
+	t_ring			*ring;
+
+	i = 0;
+	while (i < log->ring_count)
+	{
+		ring = &log->rings[i];
+		while (atomic_load(&ring->busy))
+			usleep(10);
+		head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+		while (head != atomic_load_explicit(&ring->tail, memory_order_acquire)
+			&& log->heap_len < log->heap_cap)
+		{
+			log_heap_push(log, &ring->slots[head & (LOG_RING_SIZE - 1)]);
+			head++;
+			atomic_store_explicit(&ring->head, head, memory_order_release);
+		}
+		i++;
+	}
+}
+
+/*
+** @brief: One merge round of the async writer
+** @param: table - pointer to table structure
+** @param: limit - print only events stamped before this ms (-1 = all)
+** @return: void
+**
+** limit must be read from the clock before calling, so every event that
+** is stamped earlier is guaranteed to be drained by drain_rings().
+*/
+void	logger_round(t_table *table, long limit)
+{
+	t_logger	*log;
+	t_pending	top;
+
+	log = &table->log;
+	drain_rings(log);
+	while (log->heap_len > 0 && (limit < 0 || log->heap[0].ev.ts < limit))
+	{
+		top = log_heap_pop(log);
+		log_emit(table, &top.ev);
+	}
+	log_flush(table);
+}
@@ -20,14 +20,19 @@
 ** Implementation:
 **   1. Validate argument count (argc == 5 or 6)
 **   2. Declare and initialize table structure
-**   3. Call parse_arguments()
-**   4. Call init_table()
-**   5. Call create_threads()
-**   6. Call start_monitor() (Phase 4)
-**   7. Call join_monitor()
-**   8. Call join_threads()
-**   9. Call cleanup_table()
-**   10. Return appropriate exit code
+**   3. Call parse_options() to strip "--option" flags
+**   4. Call parse_arguments(), then calibrate_sleep() (--sleep-calib)
+**   5. Call init_table(), open_sink(), open_trace() (--trace-bin only),
+**      start_logger() (--async-log only), start_outq() (--out-queue only)
+**      and start_wheel() (--timer wheel only)
+**   6. Call create_threads()
+**   7. Call start_monitor() (Phase 4)
+**   8. Call join_monitor()
+**   9. Call join_threads(), then stop_wheel() and stop_logger() /
+**      stop_outq() for the final drain
+**   10. Call report_latency() (--latency only) and report_fork_lock()
+**       (--fork-lock ticket only), then cleanup_table()
+**   11. Return appropriate exit code
 ** 
 ** Note: Monitor thread runs concurrently with philosopher threads.
 ** It detects deaths and meal completion, then signals simulation end.
@@ -37,22 +42,30 @@ int	main(int argc, char **argv)
 	t_table	table;
 
 	memset(&table, 0, sizeof(t_table));
-	if (parse_arguments(&table, argc, argv) != 0)
+	if (parse_options(&table, &argc, argv) != 0
+		|| parse_arguments(&table, argc, argv) != 0)
 		return (1);
+	calibrate_sleep(table.philo_count);
 	if (init_table(&table) != 0)
 		return (1);
-	if (create_threads(&table) != 0)
-	{
-		cleanup_table(&table);
-		return (1);
-	}
-	if (start_monitor(&table) != 0)
+	if (open_sink(&table) != 0 || open_trace(&table) != 0
+		|| start_logger(&table) != 0 || start_outq(&table) != 0
+		|| start_wheel(&table) != 0 || create_threads(&table) != 0
+		|| start_monitor(&table) != 0)
 	{
+		stop_wheel(&table);
+		stop_logger(&table);
+		stop_outq(&table);
 		cleanup_table(&table);
 		return (1);
 	}
 	join_monitor(&table);
 	join_threads(&table);
+	stop_wheel(&table);
+	stop_logger(&table);
+	stop_outq(&table);
+	report_latency(&table);
+	report_fork_lock(&table);
 	cleanup_table(&table);
 	return (0);
 }
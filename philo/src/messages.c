@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   messages.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Returns the output text of a state
+** @param: state - state code
+** @return: message without timestamp or id
+**
+** Shared by the printers, the async writer and philo_decode, so every
+** output path produces byte-identical text.
+*/
+const char	*state_msg(t_state state)
+{
+	static const char	*msgs[] = {
+		"has taken a fork",
+		"is eating",
+		"is sleeping",
+		"is thinking",
+		"died"
+	};
+
+	return (msgs[state]);
+}
+
+/*
+** @brief: Returns the line suffix of a state, newline included
+** @param: state - state code
+** @return: suffix with its precomputed length
+**
+** Lengths come from sizeof at compile time, so the formatter never
+** calls strlen() on the hot path.
+*/
+const t_msg	*state_suffix(t_state state)
+{
+	static const t_msg	suffixes[] = {
+	{"has taken a fork\n", sizeof("has taken a fork\n") - 1},
+	{"is eating\n", sizeof("is eating\n") - 1},
+	{"is sleeping\n", sizeof("is sleeping\n") - 1},
+	{"is thinking\n", sizeof("is thinking\n") - 1},
+	{"died\n", sizeof("died\n") - 1}
+	};
+
+	return (&suffixes[state]);
+}
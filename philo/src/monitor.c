@@ -15,22 +15,19 @@
 /*
 ** @brief: Checks if a philosopher has died (starvation)
 ** @param: philo - pointer to philosopher to check
-** @param: current_time - current timestamp in milliseconds
+** @param: current_time - current timestamp in ns (get_time_ns())
 ** @return: true if philosopher is dead, false otherwise
 ** 
-** Thread-safety: Protected by meal_lock mutex
-** Performance: Called every ~1ms by monitor thread
+** last_meal_time is in ns too; only time_to_die is scaled from ms.
+** Thread-safety: acquire load of the owner's last_meal_time
 */
 bool	is_philosopher_dead(t_philo *philo, long current_time)
 {
 	long	time_since_meal;
-	bool	is_dead;
 
-	pthread_mutex_lock(&philo->table->meal_lock);
-	time_since_meal = current_time - philo->last_meal_time;
-	is_dead = (time_since_meal >= philo->table->time_to_die);
-	pthread_mutex_unlock(&philo->table->meal_lock);
-	return (is_dead);
+	time_since_meal = current_time - atomic_load_explicit(
+			&philo->last_meal_time, memory_order_acquire);
+	return (time_since_meal >= philo->table->time_to_die * NS_PER_MS);
 }
 
 /*
@@ -38,104 +35,159 @@ bool	is_philosopher_dead(t_philo *philo, long current_time)
 ** @param: table - pointer to table structure
 ** @return: true if all satisfied, false otherwise
 ** 
-** Thread-safety: Protected by meal_lock mutex
+** O(1): reads the satisfied counter kept by count_satisfied() instead
+** of walking every meals_count.
 */
 bool	all_philosophers_satisfied(t_table *table)
 {
-	int		i;
-	bool	all_satisfied;
-
 	if (table->must_eat_count <= 0)
 		return (false);
-	pthread_mutex_lock(&table->meal_lock);
-	all_satisfied = true;
-	i = 0;
-	while (i < table->philo_count)
+	return (atomic_load_explicit(&table->satisfied, memory_order_acquire)
+		>= table->philo_count);
+}
+
+/*
+** @brief: Counts one more philosopher as done eating
+** @param: table - pointer to table structure
+** @return: void
+**
+** Called by eat_action() exactly once per philosopher, on the meal that
+** reaches must_eat_count. The philosopher that brings the count to N
+** ends the simulation itself and wakes the monitor so it returns too.
+*/
+void	count_satisfied(t_table *table)
+{
+	if (atomic_fetch_add_explicit(&table->satisfied, 1, memory_order_acq_rel)
+		+ 1 == table->philo_count)
 	{
-		if (table->philos[i].meals_count < table->must_eat_count)
-		{
-			all_satisfied = false;
-			break ;
-		}
-		i++;
+		end_simulation(table);
+		monitor_kick(table);
 	}
-	pthread_mutex_unlock(&table->meal_lock);
-	return (all_satisfied);
 }
 
 /*
-** @brief: Check all philosophers for death
-** @param: table - pointer to table structure
-** @param: current_time - current timestamp
+** @brief: Checks the shard's philosophers whose death deadline has passed
+** @param: mon - monitor shard
+** @param: current_time - current timestamp in ns
 ** @return: true if death detected, false otherwise
+**
+** Implementation:
+**   1. Look at the earliest deadline in the heap; stop if it is ahead
+**   2. Re-read that philosopher's last_meal_time (acquire load)
+**   3. Still due: announce the death. Otherwise it has eaten since:
+**      re-key it with its real deadline and look at the new top
+**   4. With --latency, record how late the death was announced (or,
+**      for a near-miss, how late this check came after the old key)
+**
+** O(1) per tick while nothing is due, plus O(log N) per meal, instead
+** of N meal state reads every millisecond.
 */
-static bool	check_deaths(t_table *table, long current_time)
+bool	check_deaths(t_monitor *mon, long current_time)
 {
-	int	i;
+	t_dheap	*h;
+	t_philo	*philo;
+	long	due;
 
-	i = 0;
-	while (i < table->philo_count)
+	h = &mon->deadlines;
+	while (h->size > 0 && h->nodes[0].at <= current_time)
 	{
-		if (is_philosopher_dead(&table->philos[i], current_time))
+		philo = &mon->table->philos[h->nodes[0].philo];
+		due = atomic_load_explicit(&philo->last_meal_time,
+				memory_order_acquire) + mon->table->time_to_die * NS_PER_MS;
+		if (due <= current_time)
 		{
-			announce_death(&table->philos[i]);
+			announce_death(philo);
+			if (mon->table->opts.latency != LAT_OFF)
+				lat_record(&mon->lat, get_time_ns() - due, true);
 			return (true);
 		}
-		i++;
+		if (mon->table->opts.latency == LAT_ALL)
+			lat_record(&mon->lat, current_time - h->nodes[0].at, false);
+		dheap_rekey_top(h, due);
 	}
 	return (false);
 }
 
 /*
-** @brief: Main monitor thread routine
-** @param: arg - pointer to table structure (void* cast)
+** @brief: Main monitor thread routine (one per shard)
+** @param: arg - pointer to the monitor shard (void* cast)
 ** @return: NULL
 ** 
-** Performance: ~1ms sleep = <10ms death detection, ~1-2% CPU
+** Event-driven: after each check the monitor sleeps until the earliest
+** death deadline (monitor_wake_at()), not for a fixed 1ms. A meal only
+** moves a deadline later, so it never has to cut that sleep short; the
+** philosopher that completes the must-eat goal ends the simulation
+** itself and kicks the monitor awake (count_satisfied()).
+** Shard 0's wake-ups also flush a batching output backend (print_tick(),
+** at least every MON_TICK_NS) and let the TSC clock recalibrate once a
+** second (tsc_tick()). The shard that ends the simulation kicks the
+** others out of their waits.
 */
 void	*monitor_routine(void *arg)
 {
-	t_table	*table;
+	t_monitor		*mon;
+	t_table			*table;
+	unsigned int	seq;
+	long			now;
 
-	table = (t_table *)arg;
+	mon = (t_monitor *)arg;
+	table = mon->table;
 	while (!should_end_simulation(table))
 	{
-		if (check_deaths(table, get_time_ms()))
-			return (NULL);
-		if (all_philosophers_satisfied(table))
+		seq = atomic_load_explicit(&table->mon_seq, memory_order_acquire);
+		now = get_time_ns();
+		if (check_deaths(mon, now) || all_philosophers_satisfied(table))
 		{
 			end_simulation(table);
+			monitor_kick(table);
 			return (NULL);
 		}
-		usleep(1000);
+		if (mon->index == 0)
+		{
+			print_tick(table);
+			tsc_tick();
+		}
+		monitor_wait(table, seq, monitor_wake_at(mon, now));
 	}
 	return (NULL);
 }
 
 /*
-** @brief: Starts the monitor thread
+** @brief: Starts the monitor threads, one per shard
 ** @param: table - pointer to table structure
 ** @return: 0 on success, 1 on error
 ** 
 ** Implementation:
-**   1. Create monitor thread with pthread_create
-**   2. Pass table pointer as argument to monitor_routine
+**   1. Create one monitor thread per shard with pthread_create
+**   2. Pass the shard as argument to monitor_routine
 **   3. Handle thread creation failure
-**   4. Store thread ID in table->monitor
+**   4. Store thread IDs in table->monitors[i].thread
 ** 
 ** Error handling:
-**   If thread creation fails, print error and return 1
+**   If a thread cannot be created, print error, stop and join the
+**   shards already running, and return 1
 ** 
-** Note: Monitor thread runs concurrently with philosopher threads
-** and continuously checks for death/completion conditions.
+** Note: Monitor threads run concurrently with philosopher threads
+** and continuously check for death/completion conditions.
 */
 int	start_monitor(t_table *table)
 {
-	if (pthread_create(&table->monitor, NULL, monitor_routine, table) != 0)
+	int	i;
+
+	i = 0;
+	while (i < table->monitor_count)
 	{
-		printf("Error: Failed to create monitor thread\n");
-		end_simulation(table);
-		return (1);
+		if (pthread_create(&table->monitors[i].thread, NULL, monitor_routine,
+				&table->monitors[i]) != 0)
+		{
+			printf("Error: Failed to create monitor thread\n");
+			end_simulation(table);
+			monitor_kick(table);
+			while (i-- > 0)
+				pthread_join(table->monitors[i].thread, NULL);
+			return (1);
+		}
+		i++;
 	}
 	return (0);
 }
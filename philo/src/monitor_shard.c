@@ -0,0 +1,121 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   monitor_shard.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Number of monitor shards for this table
+** @param: table - pointer to table structure (philo_count parsed)
+** @return: --monitors if given, otherwise one per MON_SHARD_MIN
+**          philosophers, capped by the online cores; never above N
+*/
+static int	monitor_count(t_table *table)
+{
+	long	count;
+	long	cores;
+
+	count = table->opts.monitors;
+	if (count == 0)
+	{
+		count = table->philo_count / MON_SHARD_MIN;
+		cores = sysconf(_SC_NPROCESSORS_ONLN);
+		if (cores > 0 && count > cores)
+			count = cores;
+		if (count > MON_MAX)
+			count = MON_MAX;
+	}
+	if (count > table->philo_count)
+		count = table->philo_count;
+	if (count < 1)
+		count = 1;
+	return (count);
+}
+
+/*
+** @brief: Splits the philosophers between the monitor shards
+** @param: table - pointer to table structure (philosophers initialized)
+** @return: 0 on success, 1 on allocation failure
+**
+** Shard k owns philos[N * k / S, N * (k + 1) / S) and builds its own
+** deadline heap over that slice (init_deadlines()).
+*/
+int	init_monitors(t_table *table)
+{
+	t_monitor	*mon;
+	int			i;
+
+	table->monitor_count = monitor_count(table);
+	table->monitors = aligned_alloc(64, sizeof(t_monitor)
+			* table->monitor_count);
+	if (!table->monitors)
+	{
+		printf("Error: Failed to allocate monitors\n");
+		return (1);
+	}
+	memset(table->monitors, 0, sizeof(t_monitor) * table->monitor_count);
+	i = 0;
+	while (i < table->monitor_count)
+	{
+		mon = &table->monitors[i];
+		mon->table = table;
+		mon->index = i;
+		mon->lo = (long)table->philo_count * i / table->monitor_count;
+		mon->hi = (long)table->philo_count * (i + 1) / table->monitor_count;
+		if (init_deadlines(mon) != 0)
+			return (1);
+		i++;
+	}
+	return (0);
+}
+
+/*
+** @brief: Releases the monitor shards and their heaps
+** @param: table - pointer to table structure
+** @return: void
+**
+** Also safe after a partial init_monitors() failure.
+*/
+void	free_monitors(t_table *table)
+{
+	int	i;
+
+	if (!table->monitors)
+		return ;
+	i = 0;
+	while (i < table->monitor_count)
+		free_deadlines(&table->monitors[i++].deadlines);
+	free(table->monitors);
+	table->monitors = NULL;
+	table->monitor_count = 0;
+}
+
+/*
+** @brief: Sets the number of monitor threads
+** @param: table - pointer to table structure
+** @param: value - "auto" (from N and the core count) or 1..MON_MAX
+** @return: 0 on success, 1 on invalid value
+*/
+int	opt_monitors(t_table *table, char *value)
+{
+	if (strcmp(value, "auto") == 0)
+	{
+		table->opts.monitors = 0;
+		return (0);
+	}
+	table->opts.monitors = ft_atoi_positive(value);
+	if (table->opts.monitors < 1 || table->opts.monitors > MON_MAX)
+	{
+		printf("Error: --monitors must be auto or 1 to %d\n", MON_MAX);
+		return (1);
+	}
+	return (0);
+}
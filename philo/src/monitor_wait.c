@@ -0,0 +1,77 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   monitor_wait.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Wakes the monitor before its timed wait runs out
+** @param: table - pointer to table structure
+** @return: void
+**
+** Bumping mon_seq first means a monitor that has not reached the futex
+** yet sees a changed word and does not sleep at all. Every shard waits
+** on the same word, so all of them are woken.
+*/
+void	monitor_kick(t_table *table)
+{
+	atomic_fetch_add_explicit(&table->mon_seq, 1, memory_order_release);
+	syscall(SYS_futex, &table->mon_seq, FUTEX_WAKE_PRIVATE, INT_MAX, NULL,
+		NULL, 0);
+}
+
+/*
+** @brief: Computes when a monitor shard has to look again
+** @param: mon - monitor shard
+** @param: now - time of the check that just ran (get_time_ns())
+** @return: wake-up time on the get_time_ns() timeline
+**
+** The earliest death deadline of the shard (top of its heap), capped by
+** the TSC clock's recalibration period and, for shard 0, by the batching
+** output flush (MON_TICK_NS, direct mode only).
+*/
+long	monitor_wake_at(t_monitor *mon, long now)
+{
+	t_dheap	*h;
+	long	at;
+
+	h = &mon->deadlines;
+	at = now + TSC_RECAL_NS;
+	if (h->size > 0 && h->nodes[0].at < at)
+		at = h->nodes[0].at;
+	if (mon->index == 0 && print_needs_tick(mon->table)
+		&& now + MON_TICK_NS < at)
+		at = now + MON_TICK_NS;
+	return (at);
+}
+
+/*
+** @brief: Sleeps until a deadline or a monitor_kick(), whichever is first
+** @param: table - pointer to table structure
+** @param: seq - mon_seq read before the checks that led to this wait
+** @param: at - wake-up time on the get_time_ns() timeline
+** @return: void
+**
+** FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC timeout. The wait
+** is converted as a distance from now, so it also holds for the coarse
+** and TSC clocks, whose readings may trail CLOCK_MONOTONIC a little.
+*/
+void	monitor_wait(t_table *table, unsigned int seq, long at)
+{
+	struct timespec	ts;
+	long			until;
+
+	until = get_mono_ns() + (at - get_time_ns());
+	ts.tv_sec = until / NS_PER_SEC;
+	ts.tv_nsec = until % NS_PER_SEC;
+	syscall(SYS_futex, &table->mon_seq, FUTEX_WAIT_BITSET_PRIVATE, seq, &ts,
+		NULL, FUTEX_BITSET_MATCH_ANY);
+}
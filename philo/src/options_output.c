@@ -0,0 +1,75 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_output.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Enables the asynchronous ring-buffer logger
+** @param: table - pointer to table structure, value - unused
+** @return: 0
+*/
+int	opt_async_log(t_table *table, char *value)
+{
+	(void)value;
+	table->opts.async_log = true;
+	return (0);
+}
+
+/*
+** @brief: Writes binary event records to a file instead of text
+** @param: table - pointer to table structure, value - trace file path
+** @return: 0
+*/
+int	opt_trace_bin(t_table *table, char *value)
+{
+	table->opts.trace_path = value;
+	return (0);
+}
+
+/*
+** @brief: Enables the bounded output queue with a full-queue policy
+** @param: table - pointer to table structure
+** @param: value - "block", "drop-oldest-non-death" or "spill-to-tempfile"
+** @return: 0 on success, 1 on unknown policy
+*/
+int	opt_out_queue(t_table *table, char *value)
+{
+	table->opts.out_queue = true;
+	if (strcmp(value, "block") == 0)
+		table->opts.queue_policy = Q_BLOCK;
+	else if (strcmp(value, "drop-oldest-non-death") == 0)
+		table->opts.queue_policy = Q_DROP_OLDEST;
+	else if (strcmp(value, "spill-to-tempfile") == 0)
+		table->opts.queue_policy = Q_SPILL;
+	else
+	{
+		printf("Error: Unknown --out-queue policy %s\n", value);
+		return (1);
+	}
+	return (0);
+}
+
+/*
+** @brief: Sets the capacity of the output queue in events
+** @param: table - pointer to table structure, value - positive integer
+** @return: 0 on success, 1 on invalid value
+*/
+int	opt_queue_size(t_table *table, char *value)
+{
+	table->opts.queue_size = ft_atoi_positive(value);
+	if (table->opts.queue_size <= 1)
+	{
+		printf("Error: --queue-size must be an integer greater than 1\n");
+		return (1);
+	}
+	return (0);
+}
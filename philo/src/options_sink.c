@@ -0,0 +1,49 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_sink.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Selects the output backend
+** @param: table - pointer to table structure
+** @param: value - "write", "writev", "io_uring", "vmsplice" or "mmap"
+** @return: 0 on success, 1 on unknown backend
+*/
+int	opt_backend(t_table *table, char *value)
+{
+	static const char	*names[] = {
+		"write", "writev", "io_uring", "vmsplice", "mmap", NULL
+	};
+	int					i;
+
+	i = 0;
+	while (names[i] && strcmp(names[i], value) != 0)
+		i++;
+	if (!names[i])
+	{
+		printf("Error: Unknown --backend %s\n", value);
+		return (1);
+	}
+	table->opts.backend = (t_backend)i;
+	return (0);
+}
+
+/*
+** @brief: Sends the text output to a file instead of stdout
+** @param: table - pointer to table structure, value - file path
+** @return: 0
+*/
+int	opt_out(t_table *table, char *value)
+{
+	table->opts.out_path = value;
+	return (0);
+}
@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   outq.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Creates the anonymous spill file (spill-to-tempfile policy)
+** @param: q - output queue
+** @return: 0 on success, 1 on error
+**
+** The file is unlinked right away, so it disappears with the process.
+*/
+static int	open_spill(t_outq *q)
+{
+	char	path[32];
+
+	memcpy(path, "/tmp/philo_spill_XXXXXX", 24);
+	q->spill_fd = mkstemp(path);
+	if (q->spill_fd < 0)
+		return (printf("Error: Cannot create spill file\n"), 1);
+	unlink(path);
+	return (0);
+}
+
+/*
+** @brief: Allocates the queue and its synchronization primitives
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+**
+** start_outq() starts the drain thread right after; events pushed
+** before that simply wait in the queue (or the spill file).
+*/
+int	init_outq(t_table *table)
+{
+	t_outq	*q;
+
+	q = &table->outq;
+	q->cap = table->opts.queue_size;
+	if (q->cap == 0)
+		q->cap = OUTQ_DEFAULT_SIZE;
+	q->slots = malloc(sizeof(t_event) * q->cap);
+	if (!table->log.buf)
+		table->log.buf = malloc(LOG_BATCH_SIZE);
+	if (!q->slots || !table->log.buf)
+		return (printf("Error: Failed to allocate output queue\n"), 1);
+	q->spill_fd = -1;
+	if (table->opts.queue_policy == Q_SPILL && open_spill(q) != 0)
+		return (1);
+	pthread_mutex_init(&q->lock, NULL);
+	pthread_cond_init(&q->not_empty, NULL);
+	pthread_cond_init(&q->not_full, NULL);
+	return (0);
+}
+
+/*
+** @brief: Starts the output queue drain thread (--out-queue only)
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+*/
+int	start_outq(t_table *table)
+{
+	if (!table->opts.out_queue)
+		return (0);
+	if (table->opts.async_log)
+		return (printf("Error: --out-queue and --async-log are exclusive\n"),
+			1);
+	if (init_outq(table) != 0)
+	{
+		free(table->outq.slots);
+		table->outq.slots = NULL;
+		return (1);
+	}
+	if (pthread_create(&table->outq.thread, NULL, outq_routine, table) != 0)
+	{
+		printf("Error: Failed to create output queue thread\n");
+		free(table->outq.slots);
+		table->outq.slots = NULL;
+		return (1);
+	}
+	return (0);
+}
+
+/*
+** @brief: Drains and stops the queue, then reports its counters
+** @param: table - pointer to table structure
+** @return: void
+**
+** Called after every producer has been joined. The dropped / spilled
+** counters go to stderr so they never mix with the simulation output.
+*/
+void	stop_outq(t_table *table)
+{
+	t_outq	*q;
+
+	q = &table->outq;
+	if (!q->slots)
+		return ;
+	pthread_mutex_lock(&q->lock);
+	q->stop = true;
+	pthread_cond_signal(&q->not_empty);
+	pthread_mutex_unlock(&q->lock);
+	pthread_join(q->thread, NULL);
+	fprintf(stderr, "output queue: %ld dropped, %ld spilled\n",
+		q->dropped, q->spilled);
+	if (q->spill_fd >= 0)
+		close(q->spill_fd);
+	pthread_mutex_destroy(&q->lock);
+	pthread_cond_destroy(&q->not_empty);
+	pthread_cond_destroy(&q->not_full);
+	free(q->slots);
+	q->slots = NULL;
+}
+
+/*
+** @brief: Appends an event to the spill file
+** @param: q - output queue (lock held)
+** @param: ev - event that did not fit in memory
+** @return: true if the event was written, false on I/O error
+*/
+bool	outq_spill(t_outq *q, const t_event *ev)
+{
+	if (pwrite(q->spill_fd, ev, sizeof(*ev), q->spill_write)
+		!= (ssize_t) sizeof(*ev))
+		return (false);
+	q->spill_write += sizeof(*ev);
+	q->spilled++;
+	return (true);
+}
@@ -0,0 +1,131 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   outq_drain.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Moves up to max events out of the in-memory ring
+** @param: q - output queue (lock held)
+** @param: batch - destination, max - capacity of batch
+** @return: number of events taken
+*/
+static int	take_batch(t_outq *q, t_event *batch, int max)
+{
+	int	n;
+
+	n = 0;
+	while (n < max && q->count > 0)
+	{
+		batch[n++] = q->slots[q->head];
+		q->head = (q->head + 1) % q->cap;
+		q->count--;
+	}
+	return (n);
+}
+
+/*
+** @brief: Prints (or traces) a batch of events with one write
+** @param: table - pointer to table structure
+** @param: batch - events in time order, n - number of events
+** @return: void
+*/
+static void	emit_batch(t_table *table, const t_event *batch, int n)
+{
+	int	i;
+
+	i = 0;
+	while (i < n)
+		log_emit(table, &batch[i++]);
+	log_flush(table);
+}
+
+/*
+** @brief: Replays spilled events, oldest first
+** @param: table - pointer to table structure
+** @param: end - spill_write snapshot taken under the lock
+** @return: void
+**
+** Only this thread advances spill_read, so the file is read without the
+** lock. Once the reader catches up with the writer, both offsets go
+** back to 0 (the file is simply overwritten next time); producers then
+** use the in-memory queue again.
+*/
+static void	drain_spill(t_table *table, off_t end)
+{
+	t_event	batch[OUTQ_BATCH];
+	t_outq	*q;
+	size_t	want;
+	ssize_t	got;
+
+	q = &table->outq;
+	want = sizeof(batch);
+	if ((off_t) want > end - q->spill_read)
+		want = end - q->spill_read;
+	got = pread(q->spill_fd, batch, want, q->spill_read);
+	if (got <= 0)
+		got = end - q->spill_read;
+	else
+		emit_batch(table, batch, got / sizeof(t_event));
+	pthread_mutex_lock(&q->lock);
+	q->spill_read += got;
+	if (q->spill_read == q->spill_write)
+	{
+		q->spill_read = 0;
+		q->spill_write = 0;
+	}
+	pthread_mutex_unlock(&q->lock);
+}
+
+/*
+** @brief: Output queue drain thread
+** @param: arg - pointer to table structure
+** @return: NULL
+**
+** Implementation:
+**   1. Wait until the queue or the spill file has events, or stop is set
+**   2. Take a batch under the lock and wake blocked producers
+**   3. Format and write it outside the lock
+**   4. With the queue empty, replay the spill file
+**   5. Exit once stop is set and everything has been written
+**
+** While a spill is in progress producers append to the file only, so
+** the queue holds strictly older events and draining it first keeps the
+** output in time order.
+*/
+void	*outq_routine(void *arg)
+{
+	t_table	*table;
+	t_outq	*q;
+	t_event	batch[OUTQ_BATCH];
+	int		n;
+	off_t	end;
+
+	table = (t_table *)arg;
+	q = &table->outq;
+	while (1)
+	{
+		pthread_mutex_lock(&q->lock);
+		while (q->count == 0 && q->spill_read == q->spill_write && !q->stop)
+			pthread_cond_wait(&q->not_empty, &q->lock);
+		n = take_batch(q, batch, OUTQ_BATCH);
+		end = q->spill_write;
+		pthread_cond_broadcast(&q->not_full);
+		pthread_mutex_unlock(&q->lock);
+		if (n == 0 && q->spill_read == end)
+			break ;
+		if (n > 0)
+			emit_batch(table, batch, n);
+		else
+			drain_spill(table, end);
+	}
+	return (NULL);
+}
@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   outq_push.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Appends an event at the tail of the in-memory ring
+** @param: q - output queue (lock held, not full)
+** @param: ev - event to append
+** @return: void
+*/
+static void	enqueue(t_outq *q, const t_event *ev)
+{
+	q->slots[(q->head + q->count) % q->cap] = *ev;
+	q->count++;
+}
+
+/*
+** @brief: Evicts the oldest event that is not a death
+** @param: q - output queue (lock held, full, cap >= 2)
+** @return: void
+**
+** There is at most one death in the queue. If it sits at the head, the
+** event right behind it is dropped instead and the death moves up one
+** slot, so it stays first in line.
+*/
+static void	drop_oldest(t_outq *q)
+{
+	int	next;
+
+	next = (q->head + 1) % q->cap;
+	if (q->slots[q->head].state == ST_DIED)
+		q->slots[next] = q->slots[q->head];
+	q->head = next;
+	q->count--;
+	q->dropped++;
+}
+
+/*
+** @brief: Queues one state change for the drain thread
+** @param: table - pointer to table structure
+** @param: id - philosopher id, state - state code
+** @return: void
+**
+** Implementation:
+**   1. Lock the queue; under "block", wait while it is full
+**   2. Stamp the event (inside the lock, so the queue stays in time order)
+**   3. If a spill is in progress or the queue is full, apply the policy:
+**      spill to the temp file, or evict the oldest non-death event
+**   4. Otherwise append it, and wake the drain thread
+**
+** A philosopher never touches stdout here, so a slow consumer can only
+** stall it under the "block" policy.
+*/
+void	outq_push(t_table *table, int id, t_state state)
+{
+	t_outq	*q;
+	t_event	ev;
+
+	q = &table->outq;
+	ev.id = id;
+	ev.state = state;
+	pthread_mutex_lock(&q->lock);
+	while (q->count == q->cap && table->opts.queue_policy == Q_BLOCK
+		&& !q->stop)
+		pthread_cond_wait(&q->not_full, &q->lock);
+	ev.ts = elapsed_ms(table->start_time);
+	if (q->spill_read < q->spill_write || q->count == q->cap)
+	{
+		if (table->opts.queue_policy != Q_SPILL || !outq_spill(q, &ev))
+		{
+			if (q->count == q->cap)
+				drop_oldest(q);
+			enqueue(q, &ev);
+		}
+	}
+	else
+		enqueue(q, &ev);
+	pthread_cond_signal(&q->not_empty);
+	pthread_mutex_unlock(&q->lock);
+}
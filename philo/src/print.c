@@ -0,0 +1,125 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   print.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Writes a whole buffer, retrying on short writes
+** @param: fd - destination, buf - data, len - byte count
+** @return: void
+*/
+void	write_all(int fd, const char *buf, size_t len)
+{
+	ssize_t	ret;
+
+	while (len > 0)
+	{
+		ret = write(fd, buf, len);
+		if (ret <= 0)
+			return ;
+		buf += ret;
+		len -= ret;
+	}
+}
+
+/*
+** @brief: Prints the philosopher's pending states in one sink_write()
+** @param: philo - philosopher owning the pending states
+** @return: void
+**
+** Same rules as safe_print(): the timestamp is taken under write_lock,
+** so lines leave in timestamp order, and nothing is printed once the
+** simulation has ended. The end flag is checked under the lock too:
+** announce_death() sets it before taking the lock, so no line can
+** follow the death line. With the default backend this is one write(2).
+*/
+void	print_flush(t_philo *philo)
+{
+	char	out[FMT_LINE_MAX * FMT_PENDING_MAX];
+	size_t	len;
+	long	ts;
+	int		i;
+
+	if (philo->pending_count == 0)
+		return ;
+	pthread_mutex_lock(&philo->table->write_lock);
+	if (!should_end_simulation(philo->table))
+	{
+		ts = elapsed_ms(philo->table->start_time);
+		len = 0;
+		i = 0;
+		while (i < philo->pending_count)
+			len += fmt_line(out + len, ts, philo, philo->pending[i++]);
+		sink_write(&philo->table->sink, out, len);
+	}
+	pthread_mutex_unlock(&philo->table->write_lock);
+	philo->pending_count = 0;
+}
+
+/*
+** @brief: Records a state change and prints it (see print_flush())
+** @param: philo - philosopher changing state, state - new state
+** @return: void
+**
+** Implementation:
+**   1. Append the state to the philosopher's pending list
+**   2. Keep fork lines pending, so "has taken a fork" x2 and "is eating"
+**      leave in a single write(2), stamped and formatted with fmt_line()
+**      (no printf) under write_lock
+**   3. Flush on every other state, or right away with one philosopher
+**      (the only fork line is never followed by a meal)
+**
+** take_forks() flushes a pending fork line before blocking on the
+** second fork, so a line is never held back across a wait and the
+** shared stamp is the time the forks were taken.
+*/
+void	print_state(t_philo *philo, t_state state)
+{
+	if (philo->pending_count == FMT_PENDING_MAX)
+		print_flush(philo);
+	philo->pending[philo->pending_count++] = state;
+	if (state != ST_FORK || philo->table->philo_count == 1)
+		print_flush(philo);
+}
+
+/*
+** @brief: Flushes the output backend from the monitor loop
+** @param: table - pointer to table structure
+** @return: void
+**
+** Only in direct mode: the writer threads flush their own batches.
+** Bounds how long a batching backend holds a line to one monitor tick.
+*/
+void	print_tick(t_table *table)
+{
+	if (!print_needs_tick(table))
+		return ;
+	pthread_mutex_lock(&table->write_lock);
+	sink_flush(&table->sink);
+	pthread_mutex_unlock(&table->write_lock);
+}
+
+/*
+** @brief: Tells whether the output needs the monitor's periodic flush
+** @param: table - pointer to table structure
+** @return: true for a staging backend (writev, io_uring, vmsplice) in
+**          direct mode, false when every line is already out
+**
+** The monitor otherwise sleeps until the next possible death.
+*/
+bool	print_needs_tick(t_table *table)
+{
+	if (table->opts.async_log || table->opts.out_queue || !table->sink.open)
+		return (false);
+	return (table->sink.kind == BK_WRITEV || table->sink.kind == BK_URING
+		|| table->sink.kind == BK_VMSPLICE);
+}
@@ -25,10 +25,8 @@
 **   5. Execute cycle: take_forks -> eat -> drop_forks -> sleep -> think
 **   6. Break loop if simulation ends
 ** 
-** Algorithm: Resource Hierarchy (Dijkstra)
-**   - No artificial delays needed (unlike even/odd approach)
-**   - Fork ordering in take_forks() prevents deadlock
-**   - All philosophers start immediately for better performance
+** Algorithm: Resource Hierarchy (Dijkstra) by default; take_forks()
+** calls the --forks strategy, each of which prevents deadlock
 */
 void	*philosopher_routine(void *arg)
 {
@@ -117,7 +115,7 @@ void	join_threads(t_table *table)
 }
 
 /*
-** @brief: Waits for monitor thread to complete
+** @brief: Waits for every monitor shard to complete
 ** @param: table - pointer to table structure
 ** @return: void
 ** 
@@ -125,5 +123,9 @@ void	join_threads(t_table *table)
 */
 void	join_monitor(t_table *table)
 {
-	pthread_join(table->monitor, NULL);
+	int	i;
+
+	i = 0;
+	while (i < table->monitor_count)
+		pthread_join(table->monitors[i++].thread, NULL);
 }
@@ -0,0 +1,145 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sink.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Opens the output file (--out) or picks stdout
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+**
+** The mmap backend maps the file, so it needs read access too.
+*/
+static int	open_out_fd(t_table *table)
+{
+	t_sink	*sink;
+
+	sink = &table->sink;
+	sink->fd = STDOUT_FILENO;
+	if (table->opts.backend == BK_MMAP && !table->opts.out_path)
+		return (printf("Error: --backend mmap needs --out <path>\n"), 1);
+	if (!table->opts.out_path)
+		return (0);
+	sink->fd = open(table->opts.out_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (sink->fd < 0)
+		return (printf("Error: Cannot open %s\n", table->opts.out_path), 1);
+	return (0);
+}
+
+/*
+** @brief: Sets up the selected output backend
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+**
+** Implementation:
+**   1. Open --out or use stdout
+**   2. writev / io_uring: allocate the staging buffer
+**   3. io_uring, vmsplice, mmap: backend specific setup
+**
+** Called before any thread starts. Until then (and in the unit tests,
+** which never open it) sink_write() falls back to write(2) on stdout.
+*/
+int	open_sink(t_table *table)
+{
+	t_sink	*sink;
+	int		ret;
+
+	sink = &table->sink;
+	sink->kind = table->opts.backend;
+	if (open_out_fd(table) != 0)
+		return (1);
+	sink->open = true;
+	ret = 0;
+	if (sink->kind == BK_WRITEV || sink->kind == BK_URING)
+	{
+		sink->cap = SINK_STAGE_SIZE;
+		sink->buf = malloc(sink->cap);
+		if (!sink->buf)
+			return (printf("Error: Failed to allocate output buffer\n"), 1);
+	}
+	if (sink->kind == BK_URING)
+		ret = uring_open(sink);
+	else if (sink->kind == BK_VMSPLICE)
+		ret = vmsplice_open(sink);
+	else if (sink->kind == BK_MMAP)
+		ret = mmap_open(sink);
+	return (ret);
+}
+
+/*
+** @brief: Hands formatted text to the output backend
+** @param: sink - output sink, buf - text, len - byte count
+** @return: void
+**
+** write and mmap put the bytes in place right away; the batching
+** backends stage them until sink_flush() or until the stage is full.
+*/
+void	sink_write(t_sink *sink, const char *buf, size_t len)
+{
+	if (!sink->open)
+		write_all(STDOUT_FILENO, buf, len);
+	else if (sink->kind == BK_WRITE)
+		write_all(sink->fd, buf, len);
+	else if (sink->kind == BK_MMAP)
+		mmap_put(sink, buf, len);
+	else if (sink->kind == BK_VMSPLICE)
+		vmsplice_put(sink, buf, len);
+	else
+		sink_stage(sink, buf, len);
+}
+
+/*
+** @brief: Pushes staged text out
+** @param: sink - output sink
+** @return: void
+**
+** Called by the monitor every tick in direct mode, after every batch by
+** the writer threads, and right after a death line.
+*/
+void	sink_flush(t_sink *sink)
+{
+	if (!sink->open)
+		return ;
+	if (sink->kind == BK_WRITEV)
+		writev_flush(sink);
+	else if (sink->kind == BK_URING)
+		uring_flush(sink);
+	else if (sink->kind == BK_VMSPLICE)
+		vmsplice_flush(sink);
+}
+
+/*
+** @brief: Flushes and releases the output backend
+** @param: sink - output sink
+** @return: void
+**
+** Also safe after a partial open_sink() failure.
+*/
+void	close_sink(t_sink *sink)
+{
+	if (!sink->open)
+		return ;
+	if (sink->buf)
+		sink_flush(sink);
+	if (sink->kind == BK_URING)
+		uring_close(sink);
+	if (sink->kind == BK_MMAP)
+		mmap_close(sink);
+	else if (sink->kind == BK_VMSPLICE && sink->buf)
+		munmap(sink->buf, sink->cap);
+	else
+		free(sink->buf);
+	if (sink->fd != STDOUT_FILENO)
+		close(sink->fd);
+	sink->buf = NULL;
+	sink->open = false;
+}
@@ -0,0 +1,91 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sink_mmap.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Sizes the --out file and maps cap bytes of it
+** @param: sink - output sink, cap - new mapping size
+** @return: 0 on success, 1 on error
+*/
+static int	map_file(t_sink *sink, size_t cap)
+{
+	void	*map;
+
+	if (ftruncate(sink->fd, cap) != 0)
+		return (1);
+	map = mmap(NULL, cap, PROT_READ | PROT_WRITE, MAP_SHARED, sink->fd, 0);
+	if (map == MAP_FAILED)
+		return (1);
+	sink->buf = map;
+	sink->cap = cap;
+	return (0);
+}
+
+/*
+** @brief: Maps the first chunk of the --out file
+** @param: sink - output sink
+** @return: 0 on success, 1 on error
+*/
+int	mmap_open(t_sink *sink)
+{
+	if (map_file(sink, SINK_MAP_CHUNK) != 0)
+		return (printf("Error: Cannot map the --out file\n"), 1);
+	return (0);
+}
+
+/*
+** @brief: Copies text straight into the file mapping
+** @param: sink - output sink, buf - text, len - byte count
+** @return: void
+**
+** No syscall per line: the page cache is written directly. The mapping
+** doubles when full; if that fails the text goes out with write(2) at
+** the right offset instead.
+*/
+void	mmap_put(t_sink *sink, const char *buf, size_t len)
+{
+	size_t	cap;
+
+	if (sink->len + len > sink->cap)
+	{
+		cap = sink->cap * 2;
+		while (cap < sink->len + len)
+			cap *= 2;
+		munmap(sink->buf, sink->cap);
+		sink->buf = NULL;
+		if (map_file(sink, cap) != 0)
+		{
+			if (pwrite(sink->fd, buf, len, sink->len) == (ssize_t)len)
+				sink->len += len;
+			return ;
+		}
+	}
+	memcpy(sink->buf + sink->len, buf, len);
+	sink->len += len;
+}
+
+/*
+** @brief: Unmaps the file and trims it to the bytes written
+** @param: sink - output sink
+** @return: void
+**
+** Until then the file is a whole number of chunks long, zero padded.
+*/
+void	mmap_close(t_sink *sink)
+{
+	if (sink->buf)
+		munmap(sink->buf, sink->cap);
+	if (ftruncate(sink->fd, sink->len) != 0)
+		printf("Error: Cannot trim the --out file\n");
+	sink->buf = NULL;
+}
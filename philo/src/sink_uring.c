@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sink_uring.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Maps the io_uring rings (single mmap for SQ and CQ)
+** @param: u - io_uring state, p - parameters filled by io_uring_setup
+** @return: 0 on success, 1 on error
+*/
+static int	map_rings(t_uring *u, struct io_uring_params *p)
+{
+	size_t	cq_size;
+
+	u->ring_size = p->sq_off.array + p->sq_entries * sizeof(unsigned int);
+	cq_size = p->cq_off.cqes + p->cq_entries * sizeof(struct io_uring_cqe);
+	if (cq_size > u->ring_size)
+		u->ring_size = cq_size;
+	u->ring = mmap(NULL, u->ring_size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_SQ_RING);
+	if (u->ring == MAP_FAILED)
+	{
+		u->ring = NULL;
+		return (1);
+	}
+	u->sqes_size = p->sq_entries * sizeof(struct io_uring_sqe);
+	u->sqes = mmap(NULL, u->sqes_size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_SQES);
+	if (u->sqes == MAP_FAILED)
+	{
+		u->sqes = NULL;
+		return (1);
+	}
+	return (0);
+}
+
+/*
+** @brief: Points the ring fields into the shared mapping
+** @param: u - io_uring state, p - parameters filled by io_uring_setup
+** @return: void
+*/
+static void	set_ring_fields(t_uring *u, struct io_uring_params *p)
+{
+	char	*base;
+
+	base = u->ring;
+	u->sq_tail = (atomic_uint *)(base + p->sq_off.tail);
+	u->sq_mask = (unsigned int *)(base + p->sq_off.ring_mask);
+	u->sq_array = (unsigned int *)(base + p->sq_off.array);
+	u->cq_head = (atomic_uint *)(base + p->cq_off.head);
+	u->cq_tail = (atomic_uint *)(base + p->cq_off.tail);
+	u->cq_mask = (unsigned int *)(base + p->cq_off.ring_mask);
+	u->cqes = (struct io_uring_cqe *)(base + p->cq_off.cqes);
+}
+
+/*
+** @brief: Sets up a small io_uring with raw syscalls (no liburing)
+** @param: sink - output sink, staging buffer already allocated
+** @return: 0 on success, 1 if io_uring is missing or too old
+**
+** Needs IORING_FEAT_SINGLE_MMAP (5.4) and IORING_FEAT_RW_CUR_POS (5.6,
+** offset -1 = "current position", which also works on pipes and ttys).
+** Only one write is ever in flight, so four entries are plenty.
+*/
+int	uring_open(t_sink *sink)
+{
+	struct io_uring_params	p;
+	t_uring					*u;
+
+	u = &sink->uring;
+	memset(&p, 0, sizeof(p));
+	u->fd = syscall(__NR_io_uring_setup, 4, &p);
+	if (u->fd < 0)
+		return (printf("Error: io_uring is not available here\n"), 1);
+	if (!(p.features & IORING_FEAT_SINGLE_MMAP)
+		|| !(p.features & IORING_FEAT_RW_CUR_POS) || map_rings(u, &p) != 0)
+		return (printf("Error: io_uring is too old or cannot be mapped\n"), 1);
+	set_ring_fields(u, &p);
+	u->spare = malloc(sink->cap);
+	if (!u->spare)
+		return (printf("Error: Failed to allocate output buffer\n"), 1);
+	return (0);
+}
+
+/*
+** @brief: Waits for the last write, then tears the ring down
+** @param: sink - output sink (already flushed)
+** @return: void
+*/
+void	uring_close(t_sink *sink)
+{
+	t_uring	*u;
+
+	u = &sink->uring;
+	if (u->ring && u->sqes)
+		uring_reap(sink);
+	if (u->sqes)
+		munmap(u->sqes, u->sqes_size);
+	if (u->ring)
+		munmap(u->ring, u->ring_size);
+	if (u->fd > 0)
+		close(u->fd);
+	free(u->spare);
+	memset(u, 0, sizeof(*u));
+}
@@ -0,0 +1,107 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sink_uring_io.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Waits for the write in flight and completes it
+** @param: sink - output sink (io_uring)
+** @return: void
+**
+** A short or failed write finishes synchronously with write(2), so the
+** output never loses or reorders bytes.
+*/
+void	uring_reap(t_sink *sink)
+{
+	t_uring			*u;
+	unsigned int	head;
+	int				res;
+
+	u = &sink->uring;
+	if (u->inflight == 0)
+		return ;
+	head = atomic_load_explicit(u->cq_head, memory_order_relaxed);
+	while (head == atomic_load_explicit(u->cq_tail, memory_order_acquire))
+		syscall(__NR_io_uring_enter, u->fd, 0, 1, IORING_ENTER_GETEVENTS,
+			NULL, 0);
+	res = u->cqes[head & *u->cq_mask].res;
+	atomic_store_explicit(u->cq_head, head + 1, memory_order_release);
+	if (res < 0)
+		res = 0;
+	if ((size_t)res < u->inflight)
+		write_all(sink->fd, u->spare + res, u->inflight - res);
+	u->inflight = 0;
+}
+
+/*
+** @brief: Queues one write of the staging buffer and submits it
+** @param: sink - output sink (io_uring), no write in flight
+** @return: true if the kernel took the request
+*/
+static bool	submit_write(t_sink *sink)
+{
+	t_uring				*u;
+	struct io_uring_sqe	*sqe;
+	unsigned int		tail;
+	unsigned int		idx;
+
+	u = &sink->uring;
+	tail = atomic_load_explicit(u->sq_tail, memory_order_relaxed);
+	idx = tail & *u->sq_mask;
+	sqe = &u->sqes[idx];
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->opcode = IORING_OP_WRITE;
+	sqe->fd = sink->fd;
+	sqe->addr = (unsigned long)sink->buf;
+	sqe->len = sink->len;
+	sqe->off = (__u64)-1;
+	u->sq_array[idx] = idx;
+	atomic_store_explicit(u->sq_tail, tail + 1, memory_order_release);
+	if (syscall(__NR_io_uring_enter, u->fd, 1, 0, 0, NULL, 0) == 1)
+		return (true);
+	atomic_store_explicit(u->sq_tail, tail, memory_order_release);
+	return (false);
+}
+
+/*
+** @brief: Submits the staged batch without waiting for it
+** @param: sink - output sink (io_uring)
+** @return: void
+**
+** Implementation:
+**   1. Reap the previous write (it must land first, and its buffer is
+**      about to be reused)
+**   2. Submit the staged buffer as one IORING_OP_WRITE
+**   3. Swap buffers: keep staging into the spare while the kernel
+**      copies out the submitted one
+**
+** If submission fails the batch is written synchronously instead.
+*/
+void	uring_flush(t_sink *sink)
+{
+	char	*tmp;
+
+	if (sink->len == 0)
+		return ;
+	uring_reap(sink);
+	if (!submit_write(sink))
+	{
+		write_all(sink->fd, sink->buf, sink->len);
+		sink->len = 0;
+		return ;
+	}
+	tmp = sink->uring.spare;
+	sink->uring.spare = sink->buf;
+	sink->buf = tmp;
+	sink->uring.inflight = sink->len;
+	sink->len = 0;
+}
@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sink_vmsplice.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#define _GNU_SOURCE
+#include "../include/philo.h"
+
+/*
+** @brief: Sets up the vmsplice page arena
+** @param: sink - output sink
+** @return: 0 on success, 1 if the output is not a pipe
+**
+** vmsplice(2) hands our pages to the pipe by reference, so a page may
+** only be rewritten once the reader has consumed it. A pipe holds at
+** most pipe_size / page buffers, so after one more pipe's worth of
+** pages has been spliced behind a page, that page is free again. The
+** arena is two pipes' worth and a batch is at most one, which keeps
+** every reused page at least one full pipe behind.
+** (This does not hold if the reader splices the pages onward instead
+** of reading them, e.g. into another pipe.)
+*/
+int	vmsplice_open(t_sink *sink)
+{
+	struct stat	st;
+	long		pipe_size;
+	void		*arena;
+
+	if (fstat(sink->fd, &st) != 0 || !S_ISFIFO(st.st_mode))
+		return (printf("Error: --backend vmsplice needs a pipe as output\n"),
+			1);
+	sink->page = sysconf(_SC_PAGESIZE);
+	pipe_size = fcntl(sink->fd, F_GETPIPE_SZ);
+	if (pipe_size < (long)sink->page)
+		pipe_size = 16 * sink->page;
+	sink->batch_max = pipe_size;
+	sink->cap = 2 * pipe_size;
+	arena = mmap(NULL, sink->cap, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (arena == MAP_FAILED)
+		return (printf("Error: Failed to map the vmsplice arena\n"), 1);
+	sink->buf = arena;
+	return (0);
+}
+
+/*
+** @brief: Copies text into the current batch of the arena
+** @param: sink - output sink, buf - text, len - byte count
+** @return: void
+*/
+void	vmsplice_put(t_sink *sink, const char *buf, size_t len)
+{
+	if (sink->len + len > sink->batch_max)
+		vmsplice_flush(sink);
+	if (len > sink->batch_max)
+	{
+		write_all(sink->fd, buf, len);
+		return ;
+	}
+	memcpy(sink->buf + sink->off + sink->len, buf, len);
+	sink->len += len;
+}
+
+/*
+** @brief: Splices the current batch into the pipe
+** @param: sink - output sink
+** @return: void
+**
+** The next batch starts on a fresh page, wrapping to the start of the
+** arena when a full batch would not fit. Whatever vmsplice(2) refuses
+** goes out with write(2).
+*/
+void	vmsplice_flush(t_sink *sink)
+{
+	struct iovec	iov;
+	ssize_t			ret;
+
+	iov.iov_base = sink->buf + sink->off;
+	iov.iov_len = sink->len;
+	while (iov.iov_len > 0)
+	{
+		ret = vmsplice(sink->fd, &iov, 1, 0);
+		if (ret <= 0)
+			break ;
+		iov.iov_base = (char *)iov.iov_base + ret;
+		iov.iov_len -= ret;
+	}
+	if (iov.iov_len > 0)
+		write_all(sink->fd, iov.iov_base, iov.iov_len);
+	sink->off += (sink->len + sink->page - 1) / sink->page * sink->page;
+	if (sink->off + sink->batch_max > sink->cap)
+		sink->off = 0;
+	sink->len = 0;
+}
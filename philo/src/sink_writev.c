@@ -0,0 +1,84 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sink_writev.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Copies text into the staging buffer
+** @param: sink - output sink (writev or io_uring)
+** @param: buf - text, len - byte count
+** @return: void
+**
+** Flushes first when the text does not fit, or when the writev batch
+** already holds SINK_IOV_MAX lines. For writev each call becomes one
+** iovec, so a batch leaves in a single writev(2).
+*/
+void	sink_stage(t_sink *sink, const char *buf, size_t len)
+{
+	if (sink->len + len > sink->cap || sink->iov_count == SINK_IOV_MAX)
+		sink_flush(sink);
+	if (len > sink->cap)
+	{
+		write_all(sink->fd, buf, len);
+		return ;
+	}
+	memcpy(sink->buf + sink->len, buf, len);
+	if (sink->kind == BK_WRITEV)
+	{
+		sink->iov[sink->iov_count].iov_base = sink->buf + sink->len;
+		sink->iov[sink->iov_count].iov_len = len;
+		sink->iov_count++;
+	}
+	sink->len += len;
+}
+
+/*
+** @brief: Skips the bytes a writev(2) call has written
+** @param: sink - output sink, i - first iovec of that call
+** @param: done - bytes written
+** @return: index of the first iovec with bytes left
+*/
+static int	skip_written(t_sink *sink, int i, size_t done)
+{
+	while (i < sink->iov_count && done >= sink->iov[i].iov_len)
+		done -= sink->iov[i++].iov_len;
+	if (i < sink->iov_count)
+	{
+		sink->iov[i].iov_base = (char *)sink->iov[i].iov_base + done;
+		sink->iov[i].iov_len -= done;
+	}
+	return (i);
+}
+
+/*
+** @brief: Writes the staged batch with writev(2)
+** @param: sink - output sink
+** @return: void
+**
+** Short writes (pipes, signals) resume at the first unwritten iovec.
+*/
+void	writev_flush(t_sink *sink)
+{
+	ssize_t	ret;
+	int		first;
+
+	first = 0;
+	while (first < sink->iov_count)
+	{
+		ret = writev(sink->fd, sink->iov + first, sink->iov_count - first);
+		if (ret <= 0)
+			break ;
+		first = skip_written(sink, first, ret);
+	}
+	sink->iov_count = 0;
+	sink->len = 0;
+}
@@ -18,29 +18,33 @@
 ** @return: void
 ** 
 ** Implementation:
-**   1. Lock sim_lock to check simulation_end flag
-**   2. If simulation ended, unlock and return (no output after death)
-**   3. Unlock sim_lock
-**   4. Lock write_lock mutex for exclusive output access
-**   5. Get current timestamp and print message
-**   6. Unlock write_lock mutex
+**   1. Return if the simulation ended (no output after death)
+**   2. Lock write_lock mutex for exclusive output access
+**   3. Get current timestamp, format the line and write(2) it
+**   4. Unlock write_lock mutex
 ** 
 ** Format: [timestamp_in_ms] [philosopher_id] [message]
+** Formatting uses fmt_number() and the precomputed id tag instead of
+** printf; state changes normally go through print_state(), this entry
+** point remains for arbitrary messages.
 */
 void	safe_print(t_philo *philo, char *msg)
 {
-	long	timestamp;
+	char	line[FMT_LINE_MAX * 2];
+	size_t	len;
+	size_t	msg_len;
 
-	pthread_mutex_lock(&philo->table->sim_lock);
-	if (philo->table->simulation_end)
-	{
-		pthread_mutex_unlock(&philo->table->sim_lock);
+	if (should_end_simulation(philo->table))
 		return ;
-	}
-	pthread_mutex_unlock(&philo->table->sim_lock);
+	msg_len = strnlen(msg, FMT_LINE_MAX);
 	pthread_mutex_lock(&philo->table->write_lock);
-	timestamp = elapsed_time(philo->table->start_time);
-	printf("%ld %d %s\n", timestamp, philo->id, msg);
+	len = fmt_number(line, elapsed_ms(philo->table->start_time));
+	memcpy(line + len, philo->tag, philo->tag_len);
+	len += philo->tag_len;
+	memcpy(line + len, msg, msg_len);
+	len += msg_len;
+	line[len++] = '\n';
+	sink_write(&philo->table->sink, line, len);
 	pthread_mutex_unlock(&philo->table->write_lock);
 }
 
@@ -50,25 +54,38 @@ void	safe_print(t_philo *philo, char *msg)
 ** @return: void
 ** 
 ** Implementation:
-**   1. Lock sim_lock to set simulation_end flag atomically
-**   2. Set simulation_end to true
-**   3. Unlock sim_lock
-**   4. Lock write_lock for exclusive output
-**   5. Print death message with timestamp
-**   6. Unlock write_lock
+**   1. Swap simulation_end to true, and return if it already was (the
+**      last philosopher to finish eating got there first)
+**   2. Lock write_lock for exclusive output
+**   3. Print death message with timestamp
+**   4. Unlock write_lock
 ** 
 ** Order matters: set flag first, then print to prevent race.
+** With --async-log the death goes through the monitor's ring instead;
+** the writer prints it after every event stamped up to the same ms and
+** drops anything that sorts after it. With --out-queue it is queued
+** like any other event (and never dropped). With --trace-bin the death
+** is recorded as a binary event. See log_death().
 */
 void	announce_death(t_philo *philo)
 {
-	long	timestamp;
+	char	line[FMT_LINE_MAX];
+	size_t	len;
 
-	pthread_mutex_lock(&philo->table->sim_lock);
-	philo->table->simulation_end = true;
-	pthread_mutex_unlock(&philo->table->sim_lock);
+	if (atomic_exchange_explicit(&philo->table->simulation_end, true,
+			memory_order_acq_rel))
+		return ;
+	if (philo->table->opts.async_log || philo->table->opts.out_queue
+		|| philo->table->trace.buf)
+	{
+		log_death(philo);
+		return ;
+	}
 	pthread_mutex_lock(&philo->table->write_lock);
-	timestamp = elapsed_time(philo->table->start_time);
-	printf("%ld %d died\n", timestamp, philo->id);
+	len = fmt_line(line, elapsed_ms(philo->table->start_time), philo,
+			ST_DIED);
+	sink_write(&philo->table->sink, line, len);
+	sink_flush(&philo->table->sink);
 	pthread_mutex_unlock(&philo->table->write_lock);
 }
 
@@ -78,21 +95,17 @@ void	announce_death(t_philo *philo)
 ** @return: 1 if should end, 0 if continue
 ** 
 ** Implementation:
-**   1. Lock sim_lock mutex for safe flag reading
-**   2. Read simulation_end flag
-**   3. Unlock sim_lock mutex
-**   4. Return flag value
+**   1. Load simulation_end (acquire, pairs with end_simulation())
+**   2. Return flag value
 ** 
-** This provides thread-safe access to the simulation state.
+** Called on every loop of every philosopher and before every printed
+** line. The flag is written once per run and sits alone on its cache
+** line, so this is a plain load from a line every core keeps shared.
 */
 int	should_end_simulation(t_table *table)
 {
-	int	result;
-
-	pthread_mutex_lock(&table->sim_lock);
-	result = table->simulation_end;
-	pthread_mutex_unlock(&table->sim_lock);
-	return (result);
+	return (atomic_load_explicit(&table->simulation_end,
+			memory_order_acquire));
 }
 
 /*
@@ -101,15 +114,13 @@ int	should_end_simulation(t_table *table)
 ** @return: void
 ** 
 ** Implementation:
-**   1. Lock sim_lock mutex for safe flag writing
-**   2. Set simulation_end to true
-**   3. Unlock sim_lock mutex
+**   1. Store simulation_end = true (release: whatever the caller did
+**      before ending is visible to a thread that sees the flag)
 ** 
-** Used by monitor when stopping conditions are met.
+** Used by the monitor, and by count_satisfied() for the last
+** philosopher to finish eating.
 */
 void	end_simulation(t_table *table)
 {
-	pthread_mutex_lock(&table->sim_lock);
-	table->simulation_end = true;
-	pthread_mutex_unlock(&table->sim_lock);
+	atomic_store_explicit(&table->simulation_end, true, memory_order_release);
 }
@@ -15,21 +15,23 @@
 /*
 ** @brief: Gets current timestamp in milliseconds
 ** @param: void
-** @return: timestamp in ms since epoch
+** @return: monotonic timestamp in ms, -1 on error
 ** 
 ** Implementation:
-**   1. Call gettimeofday() to get current time
-**   2. Convert tv_sec (seconds) to milliseconds (* 1000)
-**   3. Add tv_usec (microseconds) converted to milliseconds (/ 1000)
-**   4. Return total as long
+**   1. Read the ns clock with get_time_ns()
+**   2. Truncate to milliseconds
+**
+** Only the ms-based helpers below and callers that work in CLI units
+** use this; simulation state is kept in ns.
 */
 long	get_time_ms(void)
 {
-	struct timeval	tv;
+	long	ns;
 
-	if (gettimeofday(&tv, NULL) == -1)
+	ns = get_time_ns();
+	if (ns == -1)
 		return (-1);
-	return ((tv.tv_sec * 1000) + (tv.tv_usec / 1000));
+	return (ns / NS_PER_MS);
 }
 
 /*
@@ -53,57 +55,31 @@ long	elapsed_time(long start_time)
 ** @return: void
 ** 
 ** Implementation:
-**   1. Convert ms to microseconds (ms * 1000)
-**   2. Use usleep() for the duration
-**   3. Handle potential usleep interruptions with loop
-**   4. Ensure minimum precision for timing
+**   1. Compute the ns deadline once
+**   2. usleep() in 100us steps until the clock passes it
 */
 void	precise_sleep(long duration)
 {
-	long	start;
-	long	elapsed;
+	long	end;
 
-	start = get_time_ms();
-	while (1)
-	{
-		elapsed = get_time_ms() - start;
-		if (elapsed >= duration)
-			break ;
+	end = get_mono_ns() + duration * NS_PER_MS;
+	while (get_mono_ns() < end)
 		usleep(100);
-	}
 }
 
 /*
-** @brief: Enhanced sleep with busy-wait for precision
+** @brief: Sleeps for a duration with the calibrated spin-then-sleep timer
 ** @param: duration - sleep time in milliseconds
 ** @return: void
 ** 
 ** Implementation:
-**   1. Get start time
-**   2. Use usleep for 90% of duration (bulk sleep)
-**   3. Busy-wait for remaining 10% for precision
-**   4. Check elapsed time continuously in busy-wait
+**   1. Compute the ns deadline once
+**   2. Hand it to sleep_until()
 ** 
-** This approach reduces CPU usage while maintaining precision:
-** - usleep saves CPU during most of the wait
-** - busy-wait ensures we don't oversleep
+** The bulk-sleep margin and spin window are no longer hardcoded: they
+** come from the startup calibration of this host (see calib.c).
 */
 void	smart_sleep(long duration)
 {
-	long	start;
-	long	remaining;
-
-	start = get_time_ms();
-	while (1)
-	{
-		remaining = duration - (get_time_ms() - start);
-		if (remaining <= 0)
-			break ;
-		if (remaining > 10)
-			usleep((remaining - 5) * 1000);
-		else if (remaining > 2)
-			usleep(1000);
-		else
-			usleep(200);
-	}
+	sleep_until(get_mono_ns() + duration * NS_PER_MS);
 }
@@ -0,0 +1,146 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Writes buffered trace records to the trace file
+** @param: trace - trace writer
+** @return: void
+*/
+static void	flush_trace(t_trace *trace)
+{
+	write_all(trace->fd, (const char *)trace->buf, trace->len);
+	trace->len = 0;
+}
+
+/*
+** @brief: Opens the --trace-bin file and writes its header
+** @param: table - pointer to table structure
+** @return: 0 on success (or tracing disabled), 1 on error
+*/
+int	open_trace(t_table *table)
+{
+	t_trace	*trace;
+
+	trace = &table->trace;
+	if (!table->opts.trace_path)
+		return (0);
+	if (table->philo_count > TRACE_MAX_ID)
+		return (printf("Error: --trace-bin supports at most %d philosophers\n",
+				TRACE_MAX_ID), 1);
+	trace->fd = open(table->opts.trace_path,
+			O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (trace->fd < 0)
+		return (printf("Error: Cannot open %s\n", table->opts.trace_path), 1);
+	trace->buf = malloc(LOG_BATCH_SIZE);
+	if (!trace->buf)
+	{
+		close(trace->fd);
+		return (printf("Error: Failed to allocate trace buffer\n"), 1);
+	}
+	trace->id_bytes = 1 + (table->philo_count > TRACE_SHORT_ID);
+	memcpy(trace->buf, TRACE_MAGIC, 4);
+	memset(trace->buf + 4, 0, 4);
+	trace->buf[4] = TRACE_VERSION;
+	trace->buf[5] = trace->id_bytes;
+	trace->len = TRACE_HEADER_SIZE;
+	trace->last_ts = 0;
+	return (0);
+}
+
+/*
+** @brief: Appends a little endian value of len bytes
+** @param: dst - destination, value - value, len - byte count
+** @return: len
+*/
+static size_t	put_le(unsigned char *dst, long value, size_t len)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < len)
+	{
+		dst[i] = (value >> (8 * i)) & 0xff;
+		i++;
+	}
+	return (len);
+}
+
+/*
+** @brief: Appends one event as a variable-width record
+** @param: trace - trace writer, ts - event time (ms since start)
+** @param: id - philosopher id, state - state code
+** @return: void
+**
+** No text formatting happens here: 2 bytes per event in the common
+** case (one more with over 255 philosophers), 2 more when the gap since
+** the previous event is 30 ms or longer, 4 more past 65 s.
+*/
+void	trace_record(t_trace *trace, long ts, int id, t_state state)
+{
+	long			delta;
+	unsigned char	*rec;
+	size_t			len;
+
+	if (trace->len + 8 > LOG_BATCH_SIZE)
+		flush_trace(trace);
+	delta = ts - trace->last_ts;
+	if (delta < 0)
+		delta = 0;
+	trace->last_ts += delta;
+	rec = trace->buf + trace->len;
+	len = 1 + put_le(rec + 1, id, trace->id_bytes);
+	if (delta < TRACE_DELTA_ESC)
+		rec[0] = (delta << 3) | state;
+	else if (delta <= 0xffff)
+	{
+		rec[0] = (TRACE_DELTA_ESC << 3) | state;
+		len += put_le(rec + len, delta, 2);
+	}
+	else
+	{
+		rec[0] = (TRACE_DELTA_LONG << 3) | state;
+		len += put_le(rec + len, delta, 4);
+	}
+	trace->len += len;
+}
+
+/*
+** @brief: Stamps and records an event in synchronous mode
+** @param: table - pointer to table structure
+** @param: id - philosopher id, state - state code
+** @return: void
+**
+** The timestamp is taken under write_lock so records stay in time order.
+*/
+void	trace_emit(t_table *table, int id, t_state state)
+{
+	pthread_mutex_lock(&table->write_lock);
+	trace_record(&table->trace, elapsed_ms(table->start_time), id, state);
+	pthread_mutex_unlock(&table->write_lock);
+}
+
+/*
+** @brief: Flushes and closes the trace file
+** @param: trace - trace writer (no-op if never opened)
+** @return: void
+*/
+void	close_trace(t_trace *trace)
+{
+	if (!trace->buf)
+		return ;
+	flush_trace(trace);
+	close(trace->fd);
+	free(trace->buf);
+	trace->buf = NULL;
+}
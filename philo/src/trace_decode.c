@@ -0,0 +1,110 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_decode.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Reads exactly len bytes from a stream
+** @param: f - input stream, dst - destination, len - byte count
+** @return: 0 on success, 1 on end of file or short read
+*/
+static int	read_exact(FILE *f, unsigned char *dst, size_t len)
+{
+	return (fread(dst, 1, len, f) != len);
+}
+
+/*
+** @brief: Reads a little endian value of len bytes
+** @param: f - input stream, value - result, len - byte count
+** @return: 0 on success, 1 on end of file or short read
+*/
+static int	read_le(FILE *f, long *value, size_t len)
+{
+	unsigned char	buf[4];
+	size_t			i;
+
+	if (read_exact(f, buf, len))
+		return (1);
+	*value = 0;
+	i = len;
+	while (i-- > 0)
+		*value = (*value << 8) | buf[i];
+	return (0);
+}
+
+/*
+** @brief: Checks the trace header
+** @param: f - input stream
+** @return: width of the id field (1 or 2), 0 if the header is invalid
+*/
+static int	check_header(FILE *f)
+{
+	unsigned char	hdr[TRACE_HEADER_SIZE];
+
+	if (read_exact(f, hdr, TRACE_HEADER_SIZE)
+		|| memcmp(hdr, TRACE_MAGIC, 4) != 0)
+	{
+		fprintf(stderr, "Error: Not a philo trace file\n");
+		return (0);
+	}
+	if (hdr[4] != TRACE_VERSION || (hdr[5] != 1 && hdr[5] != 2))
+	{
+		fprintf(stderr, "Error: Unsupported trace version %d\n", hdr[4]);
+		return (0);
+	}
+	return (hdr[5]);
+}
+
+/*
+** @brief: Decodes every record and prints it as text
+** @param: f - input stream positioned after the header
+** @param: id_bytes - width of the id field, out - text destination
+** @return: 0 on success, 1 on a truncated or corrupt record
+*/
+static int	decode_records(FILE *f, int id_bytes, FILE *out)
+{
+	unsigned char	head;
+	long			id;
+	long			ts;
+	long			delta;
+
+	ts = 0;
+	while (!read_exact(f, &head, 1))
+	{
+		delta = head >> 3;
+		if (read_le(f, &id, id_bytes)
+			|| (delta == TRACE_DELTA_ESC && read_le(f, &delta, 2))
+			|| (delta == TRACE_DELTA_LONG && read_le(f, &delta, 4)))
+			return (fprintf(stderr, "Error: Truncated record\n"), 1);
+		if ((head & 7) > ST_DIED)
+			return (fprintf(stderr, "Error: Corrupt record\n"), 1);
+		ts += delta;
+		fprintf(out, "%ld %ld %s\n", ts, id, state_msg(head & 7));
+	}
+	return (0);
+}
+
+/*
+** @brief: Decodes a --trace-bin stream back to the simulation's text
+** @param: in - trace stream, out - text destination
+** @return: 0 on success, 1 on a bad header or a truncated or corrupt
+**          record
+*/
+int	trace_decode(FILE *in, FILE *out)
+{
+	int	id_bytes;
+
+	id_bytes = check_header(in);
+	if (id_bytes == 0)
+		return (1);
+	return (decode_records(in, id_bytes, out));
+}
@@ -0,0 +1,235 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tsc.c                                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** TSC clock (--clock tsc): ns = base_ns + ((tsc - base_tsc) * mult >> 32),
+** read with one rdtsc and no syscall. mult is calibrated against
+** CLOCK_MONOTONIC at startup and refined every TSC_RECAL_NS by the
+** monitor (tsc_tick()). Only x86-64 with an invariant TSC (constant
+** rate across P-states and C-states) qualifies; anything else falls
+** back to clock_gettime().
+*/
+
+/*
+** @brief: TSC clock state
+** @param: void
+** @return: pointer to the state (inactive until tsc_init() succeeds)
+**
+** base_tsc/base_ns/mult are published under the seq seqlock: readers
+** never block, and the only writer is the monitor thread.
+*/
+t_tsc	*tsc_state(void)
+{
+	static t_tsc	tsc;
+
+	return (&tsc);
+}
+
+#if defined(__x86_64__)
+
+static bool	tsc_invariant(void)
+{
+	unsigned int	eax;
+	unsigned int	ebx;
+	unsigned int	ecx;
+	unsigned int	edx;
+
+	if (__get_cpuid_max(0x80000000, NULL) < 0x80000007
+		|| !__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+		return (false);
+	return ((edx & (1U << 8)) != 0);
+}
+
+/*
+** @brief: Reads CLOCK_MONOTONIC and the TSC at (almost) the same instant
+** @param: tsc - filled with the TSC at the middle of the clock read
+** @return: CLOCK_MONOTONIC in ns
+**
+** Keeps the tightest of TSC_PAIR_TRIES bracketed reads, so a preemption
+** between the two counters does not skew the calibration.
+*/
+static long	read_pair(unsigned long *tsc)
+{
+	unsigned long	t0;
+	unsigned long	t1;
+	unsigned long	best;
+	long			ns;
+	int				i;
+
+	best = (unsigned long)-1;
+	*tsc = 0;
+	ns = 0;
+	i = 0;
+	while (i++ < TSC_PAIR_TRIES)
+	{
+		t0 = __rdtsc();
+		ns = get_mono_ns();
+		t1 = __rdtsc();
+		if (t1 - t0 < best)
+		{
+			best = t1 - t0;
+			*tsc = t0 + best / 2;
+		}
+	}
+	return (ns);
+}
+
+/*
+** @brief: Current time from the TSC
+** @param: void
+** @return: ns on the CLOCK_MONOTONIC time base
+*/
+long	tsc_now_ns(void)
+{
+	t_tsc			*t;
+	unsigned int	seq;
+	unsigned long	tsc;
+	long			ns;
+
+	t = tsc_state();
+	while (1)
+	{
+		seq = atomic_load_explicit(&t->seq, memory_order_acquire);
+		tsc = __rdtsc();
+		ns = atomic_load_explicit(&t->base_ns, memory_order_relaxed)
+			+ (long)(((unsigned __int128)(tsc - atomic_load_explicit(
+							&t->base_tsc, memory_order_relaxed))
+					* atomic_load_explicit(&t->mult, memory_order_relaxed))
+				>> 32);
+		atomic_thread_fence(memory_order_acquire);
+		if (!(seq & 1)
+			&& atomic_load_explicit(&t->seq, memory_order_relaxed) == seq)
+			return (ns);
+	}
+}
+
+/*
+** @brief: Publishes a new base and slope
+** @param: t - state, tsc/ns - new base point, mult - ns per cycle << 32
+** @return: void
+*/
+static void	publish(t_tsc *t, unsigned long tsc, long ns, unsigned long mult)
+{
+	atomic_fetch_add_explicit(&t->seq, 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	atomic_store_explicit(&t->base_tsc, tsc, memory_order_relaxed);
+	atomic_store_explicit(&t->base_ns, ns, memory_order_relaxed);
+	atomic_store_explicit(&t->mult, mult, memory_order_relaxed);
+	atomic_fetch_add_explicit(&t->seq, 1, memory_order_release);
+}
+
+/*
+** @brief: Refines the slope against CLOCK_MONOTONIC
+** @param: t - state
+** @return: void
+**
+** Implementation:
+**   1. Measure ns per cycle since the previous calibration point
+**   2. Give up on the TSC (fall back to clock_gettime) if the rate
+**      moved by more than 1/TSC_MAX_SKEW: the TSC is not trustworthy
+**   3. Rebase at max(CLOCK_MONOTONIC, current TSC time), so the clock
+**      never steps backwards
+*/
+static void	recalibrate(t_tsc *t)
+{
+	unsigned long	tsc;
+	long			ns;
+	long			prev;
+	unsigned long	mult;
+
+	ns = read_pair(&tsc);
+	if (tsc <= t->cal_tsc || ns <= t->cal_ns)
+		return ;
+	mult = (unsigned long)(((unsigned __int128)(ns - t->cal_ns) << 32)
+			/ (tsc - t->cal_tsc));
+	if (t->cal_mult && (mult > t->cal_mult + t->cal_mult / TSC_MAX_SKEW
+			|| mult < t->cal_mult - t->cal_mult / TSC_MAX_SKEW))
+	{
+		atomic_store(&t->active, false);
+		fprintf(stderr, "tsc: rate changed, falling back to clock_gettime\n");
+		return ;
+	}
+	prev = tsc_now_ns();
+	if (prev < ns)
+		prev = ns;
+	publish(t, tsc, prev, mult);
+	t->cal_tsc = tsc;
+	t->cal_ns = ns;
+	t->cal_mult = mult;
+}
+
+/*
+** @brief: Calibrates and enables the TSC clock
+** @param: void
+** @return: true if the TSC clock is active
+**
+** A first TSC_CAL_NS busy-wait gives the initial slope; tsc_tick()
+** then refines it over TSC_RECAL_NS periods.
+*/
+bool	tsc_init(void)
+{
+	t_tsc			*t;
+	unsigned long	tsc;
+	long			ns;
+
+	t = tsc_state();
+	if (!tsc_invariant())
+		return (false);
+	t->cal_ns = read_pair(&t->cal_tsc);
+	while (get_mono_ns() - t->cal_ns < TSC_CAL_NS)
+		;
+	ns = read_pair(&tsc);
+	t->cal_mult = (unsigned long)(((unsigned __int128)(ns - t->cal_ns) << 32)
+			/ (tsc - t->cal_tsc));
+	if (t->cal_mult == 0)
+		return (false);
+	publish(t, tsc, ns, t->cal_mult);
+	t->cal_tsc = tsc;
+	t->cal_ns = ns;
+	atomic_store(&t->active, true);
+	return (true);
+}
+
+/*
+** @brief: Periodic recalibration, called from the monitor loop
+** @param: void
+** @return: void
+*/
+void	tsc_tick(void)
+{
+	t_tsc	*t;
+
+	t = tsc_state();
+	if (atomic_load_explicit(&t->active, memory_order_relaxed)
+		&& tsc_now_ns() - t->cal_ns >= TSC_RECAL_NS)
+		recalibrate(t);
+}
+
+#else
+
+long	tsc_now_ns(void)
+{
+	return (get_mono_ns());
+}
+
+bool	tsc_init(void)
+{
+	return (false);
+}
+
+void	tsc_tick(void)
+{
+}
+
+#endif
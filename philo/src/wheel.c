@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   wheel.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** Hierarchical timer wheel (Varghese & Lauck), as in the classic Linux
+** timer code. Level n has WHEEL_SLOTS slots of 64^n ticks each; a timer
+** is filed in the lowest level whose range covers it, and moves down a
+** level ("cascades") when the level below wraps around to its slot.
+** Every operation is O(1) except the cascade, which is amortised.
+** All of it runs under wheel->lock.
+*/
+
+static int	slot_of(long tick, int level)
+{
+	return ((tick >> (WHEEL_SHIFT * level)) & WHEEL_MASK);
+}
+
+/*
+** @brief: Files a timer in the slot matching its expiry tick
+** @param: w - wheel, t - timer with expiry set
+** @return: void
+**
+** Expiries already due go to the next tick; expiries beyond the last
+** level are clamped to its farthest slot and refiled when it cascades.
+*/
+void	wheel_insert(t_wheel *w, t_timer *t)
+{
+	long	delta;
+	int		level;
+	int		slot;
+
+	if (t->expiry <= w->now_tick)
+		t->expiry = w->now_tick + 1;
+	delta = t->expiry - w->now_tick;
+	level = 0;
+	while (level < WHEEL_LEVELS - 1
+		&& delta >= 1L << (WHEEL_SHIFT * (level + 1)))
+		level++;
+	if (delta >= 1L << (WHEEL_SHIFT * WHEEL_LEVELS))
+		slot = (slot_of(w->now_tick, level) - 1) & WHEEL_MASK;
+	else
+		slot = slot_of(t->expiry, level);
+	t->next = w->slots[level][slot];
+	w->slots[level][slot] = t;
+	w->occupied[level] |= 1UL << slot;
+}
+
+/*
+** @brief: Empties one slot and refiles its timers in lower levels
+** @param: w - wheel, level - level of the slot, slot - slot index
+** @return: void
+*/
+static void	cascade(t_wheel *w, int level, int slot)
+{
+	t_timer	*t;
+	t_timer	*next;
+
+	t = w->slots[level][slot];
+	w->slots[level][slot] = NULL;
+	w->occupied[level] &= ~(1UL << slot);
+	while (t)
+	{
+		next = t->next;
+		wheel_insert(w, t);
+		t = next;
+	}
+}
+
+/*
+** @brief: Processes every tick up to now_tick, firing due timers
+** @param: w - wheel, now_tick - current time in ticks
+** @return: void
+**
+** Implementation:
+**   1. Step now_tick one tick at a time
+**   2. When a level wraps to slot 0, cascade the next level's slot
+**   3. Fire the level-0 slot of the tick with wheel_fire()
+*/
+void	wheel_advance(t_wheel *w, long now_tick)
+{
+	int		level;
+	int		slot;
+	t_timer	*t;
+	t_timer	*next;
+
+	while (w->now_tick < now_tick)
+	{
+		w->now_tick++;
+		level = 1;
+		while (level < WHEEL_LEVELS && slot_of(w->now_tick, level - 1) == 0)
+		{
+			cascade(w, level, slot_of(w->now_tick, level));
+			level++;
+		}
+		slot = slot_of(w->now_tick, 0);
+		t = w->slots[0][slot];
+		w->slots[0][slot] = NULL;
+		w->occupied[0] &= ~(1UL << slot);
+		while (t)
+		{
+			next = t->next;
+			wheel_fire(t);
+			t = next;
+		}
+	}
+}
+
+/*
+** @brief: Next tick the timer thread has to wake up for
+** @param: w - wheel
+** @return: tick of the next occupied level-0 slot, or of the next
+**          cascade when only higher levels hold timers; -1 when empty
+*/
+long	wheel_next(const t_wheel *w)
+{
+	unsigned long	ahead;
+	int				pos;
+	int				level;
+
+	pos = (w->now_tick + 1) & WHEEL_MASK;
+	ahead = w->occupied[0] >> pos;
+	if (pos && ahead)
+		return (w->now_tick + 1 + __builtin_ctzl(ahead));
+	if (!pos && w->occupied[0])
+		return (w->now_tick + 1 + __builtin_ctzl(w->occupied[0]));
+	level = 1;
+	while (level < WHEEL_LEVELS && !w->occupied[level])
+		level++;
+	if (level == WHEEL_LEVELS && !w->occupied[0])
+		return (-1);
+	return ((w->now_tick | WHEEL_MASK) + 1);
+}
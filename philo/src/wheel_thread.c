@@ -0,0 +1,169 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   wheel_thread.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** @brief: Wakes the philosopher waiting on a timer
+** @param: t - timer taken out of the wheel
+** @return: void
+**
+** The release store pairs with the acquire load in wheel_sleep(); once
+** fired is set the timer belongs to its philosopher again.
+*/
+void	wheel_fire(t_timer *t)
+{
+	atomic_store_explicit(&t->fired, 1, memory_order_release);
+	syscall(SYS_futex, &t->fired, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+/*
+** @brief: Timer thread routine
+** @param: arg - pointer to the wheel (void* cast)
+** @return: NULL
+**
+** Implementation:
+**   1. Ask the wheel for the next tick that has work (wheel_next())
+**   2. Sleep on cond until that tick, or forever when the wheel is
+**      empty; wheel_sleep() signals cond for an earlier timer
+**   3. Advance the wheel to the current tick, firing due timers
+**
+** This is the only thread that wakes up for timeouts: philosophers
+** sleep in the kernel until their own timer fires.
+*/
+static void	*wheel_routine(void *arg)
+{
+	t_wheel			*w;
+	struct timespec	ts;
+
+	w = (t_wheel *)arg;
+	pthread_mutex_lock(&w->lock);
+	while (!w->stop)
+	{
+		w->next_tick = wheel_next(w);
+		if (w->next_tick < 0)
+			pthread_cond_wait(&w->cond, &w->lock);
+		else
+		{
+			ts.tv_sec = w->next_tick * WHEEL_TICK_NS / NS_PER_SEC;
+			ts.tv_nsec = w->next_tick * WHEEL_TICK_NS % NS_PER_SEC;
+			pthread_cond_timedwait(&w->cond, &w->lock, &ts);
+		}
+		wheel_advance(w, get_mono_ns() / WHEEL_TICK_NS);
+	}
+	pthread_mutex_unlock(&w->lock);
+	return (NULL);
+}
+
+/*
+** @brief: Starts the timer thread (--timer wheel only)
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+**
+** cond waits on CLOCK_MONOTONIC, the clock the deadlines are taken on.
+*/
+int	start_wheel(t_table *table)
+{
+	t_wheel				*w;
+	pthread_condattr_t	attr;
+
+	if (table->opts.timer != TM_WHEEL)
+		return (0);
+	w = &table->wheel;
+	memset(w, 0, sizeof(t_wheel));
+	w->now_tick = get_mono_ns() / WHEEL_TICK_NS;
+	w->next_tick = -1;
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	if (pthread_mutex_init(&w->lock, NULL) != 0
+		|| pthread_cond_init(&w->cond, &attr) != 0
+		|| pthread_create(&w->thread, NULL, wheel_routine, w) != 0)
+	{
+		pthread_condattr_destroy(&attr);
+		printf("Error: Failed to create timer thread\n");
+		return (1);
+	}
+	pthread_condattr_destroy(&attr);
+	w->running = true;
+	return (0);
+}
+
+/*
+** @brief: Stops the timer thread
+** @param: table - pointer to table structure
+** @return: void
+**
+** Must be called after the philosophers have been joined: until then
+** one of them may still be waiting for its timer.
+*/
+void	stop_wheel(t_table *table)
+{
+	t_wheel	*w;
+
+	w = &table->wheel;
+	if (!w->running)
+		return ;
+	pthread_mutex_lock(&w->lock);
+	w->stop = true;
+	pthread_cond_signal(&w->cond);
+	pthread_mutex_unlock(&w->lock);
+	pthread_join(w->thread, NULL);
+	pthread_cond_destroy(&w->cond);
+	pthread_mutex_destroy(&w->lock);
+	w->running = false;
+}
+
+/*
+** @brief: Blocks until an absolute deadline, woken by the timer thread
+** @param: w - wheel, t - the caller's timer, deadline - ns (mono clock)
+** @return: void
+**
+** Implementation:
+**   1. Return at once if the deadline has passed
+**   2. File the timer for the first tick at or after the deadline,
+**      and wake the timer thread if it planned to sleep past it
+**   3. futex-wait on fired (no spinning, no periodic wake-ups)
+*/
+void	wheel_sleep(t_wheel *w, t_timer *t, long deadline)
+{
+	if (deadline <= get_mono_ns())
+		return ;
+	atomic_store_explicit(&t->fired, 0, memory_order_relaxed);
+	t->expiry = (deadline + WHEEL_TICK_NS - 1) / WHEEL_TICK_NS;
+	pthread_mutex_lock(&w->lock);
+	wheel_insert(w, t);
+	if (w->next_tick < 0 || t->expiry < w->next_tick)
+		pthread_cond_signal(&w->cond);
+	pthread_mutex_unlock(&w->lock);
+	while (atomic_load_explicit(&t->fired, memory_order_acquire) == 0)
+		syscall(SYS_futex, &t->fired, FUTEX_WAIT_PRIVATE, 0, NULL, NULL, 0);
+}
+
+/*
+** @brief: Selects who times the eat/sleep/think phases
+** @param: table - pointer to table structure
+** @param: value - "local" (each thread sleeps itself) or "wheel"
+** @return: 0 on success, 1 on unknown kind
+*/
+int	opt_timer(t_table *table, char *value)
+{
+	if (strcmp(value, "local") == 0)
+		table->opts.timer = TM_LOCAL;
+	else if (strcmp(value, "wheel") == 0)
+		table->opts.timer = TM_WHEEL;
+	else
+	{
+		printf("Error: Unknown --timer %s\n", value);
+		return (1);
+	}
+	return (0);
+}
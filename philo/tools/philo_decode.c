@@ -0,0 +1,42 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_decode.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo.h"
+
+/*
+** Offline decoder for --trace-bin files (philo and philo_bonus share the
+** format). Prints the exact text the simulation would have printed:
+**   ./philo_decode trace.bin > run.log
+*/
+
+/*
+** @brief: Entry point of the decoder
+** @param: argc - argument count, argv - [trace file] (stdin if omitted)
+** @return: 0 on success, 1 on error
+*/
+int	main(int argc, char **argv)
+{
+	FILE	*f;
+	int		ret;
+
+	f = stdin;
+	if (argc > 2)
+		return (fprintf(stderr, "Usage: %s [trace.bin]\n", argv[0]), 1);
+	if (argc == 2)
+		f = fopen(argv[1], "rb");
+	if (!f)
+		return (fprintf(stderr, "Error: Cannot open %s\n", argv[1]), 1);
+	ret = trace_decode(f, stdout);
+	if (f != stdin)
+		fclose(f);
+	return (ret);
+}
@@ -18,33 +18,288 @@
 # include <unistd.h>
 # include <string.h>
 # include <sys/time.h>
+# include <time.h>
 # include <pthread.h>
 # include <semaphore.h>
 # include <signal.h>
 # include <sys/wait.h>
 # include <fcntl.h>
+# include <errno.h>
 # include <stdbool.h>
+# include <sched.h>
+# include <sys/mman.h>
+# include <stdatomic.h>
+# include <sys/prctl.h>
+# include <limits.h>
+# include <sys/syscall.h>
+# include <linux/futex.h>
+# if defined(__x86_64__)
+#  include <cpuid.h>
+#  include <x86intrin.h>
+# endif
+
+/*
+** Time is kept in ns from CLOCK_MONOTONIC (start_time, last_meal_time);
+** the CLI arguments stay in ms and printed timestamps are cut to ms.
+*/
+# define NS_PER_SEC 1000000000L
+# define NS_PER_MS 1000000L
+
+/*
+** Each philosopher sleeps to absolute deadlines chained from the
+** previous one (schedule_bonus.c). A fork wait longer than this
+** restarts the chain from the moment the forks are held.
+*/
+# define PHASE_SLACK_NS 1000000L
+
+/*
+** TSC clock (--clock tsc): length of the startup calibration, period of
+** the monitor's recalibration, bracketed reads per calibration point,
+** and the rate change (1/TSC_MAX_SKEW) that disables it.
+*/
+# define TSC_CAL_NS 10000000L
+# define TSC_RECAL_NS 1000000000L
+# define TSC_PAIR_TRIES 8
+# define TSC_MAX_SKEW 100
+
+/*
+** Startup sleep calibration (--sleep-calib): number and length of the
+** probe sleeps, and the most a sleep may spin instead of sleeping.
+*/
+# define CALIB_SAMPLES 64
+# define CALIB_SLEEP_NS 500000L
+# define CALIB_MAX_MARGIN_NS 2000000L
+
+/*
+** Death detection latency histogram (--latency): LAT_BUCKETS power-of-two
+** buckets in us, and the announcement deadline the project promises.
+*/
+# define LAT_BUCKETS 18
+# define LAT_SLA_NS 10000000L
+
+/*
+** Binary trace format (--trace-bin), identical to philo's so the same
+** philo_decode tool reads both: 8-byte header "PHTR" + version + id
+** width + 2 zero bytes, then records (delta_ms << 3 | state, then a 1-
+** or 2-byte id), with a 2-byte delta appended when the delta field is
+** TRACE_DELTA_ESC and a 4-byte one when it is TRACE_DELTA_LONG.
+*/
+# define TRACE_MAGIC "PHTR"
+# define TRACE_VERSION 2
+# define TRACE_HEADER_SIZE 8
+# define TRACE_DELTA_ESC 30
+# define TRACE_DELTA_LONG 31
+# define TRACE_SHORT_ID 255
+# define TRACE_MAX_ID 65535
+
+/*
+** Formatter sizes: " <id> " tag, one formatted line, and the buffer
+** that coalesces fork, fork, eat into a single write(2).
+*/
+# define FMT_TAG_SIZE 16
+# define FMT_LINE_MAX 64
+
+/*
+** Shared log ring: slots (power of two) in the MAP_SHARED ring, and the
+** parent's output buffer.
+*/
+# define SHRING_SIZE 65536
+# define LOG_BATCH_SIZE 65536
 
 /*
 ** Bonus part uses:
 ** - Processes (fork()) instead of threads
 ** - Semaphores (sem_open, sem_wait, sem_post) instead of mutexes
 ** - Each philosopher is a separate process
-** - Each process has its own monitor thread
+** - Each process has its own monitor thread (or, with --monitor
+**   parent, one monitor thread in the parent watches them all)
 ** - Main process waits for first death or completion
 */
 
 typedef struct s_table	t_table;
 
+/*
+** Printable state changes; values match philo's so trace files are
+** interchangeable.
+*/
+typedef enum e_state
+{
+	ST_FORK,
+	ST_EAT,
+	ST_SLEEP,
+	ST_THINK,
+	ST_DIED
+}	t_state;
+
+/*
+** Death detection latency (--latency, latency_bonus.c): the gap between
+** a philosopher's real deadline and its death announcement, plus with
+** LAT_ALL how late each monitor wake-up came for a deadline the
+** philosopher then turned out to have beaten (a near-miss). Bucket k
+** holds gaps in [2^(k-1), 2^k) us. The histogram is MAP_SHARED, so every
+** child adds to the one the parent prints.
+*/
+typedef enum e_lat_mode
+{
+	LAT_OFF,
+	LAT_DEATHS,
+	LAT_ALL
+}	t_lat_mode;
+
+typedef struct s_lat_hist
+{
+	atomic_ulong		buckets[LAT_BUCKETS];
+	atomic_ulong		deaths;
+	atomic_ulong		near_misses;
+	atomic_ulong		over_sla;
+	atomic_long			max_ns;
+}	t_lat_hist;
+
+/*
+** Who detects deaths (--monitor, parent_monitor_bonus.c): a monitor
+** thread in every child, or one thread in the parent reading a
+** MAP_SHARED meal table. Each slot has its own cache line; the child
+** publishes every meal time and sets done before it exits full.
+*/
+typedef enum e_mon_mode
+{
+	MON_CHILD,
+	MON_PARENT
+}	t_mon_mode;
+
+typedef struct s_meal_slot
+{
+	_Alignas(64) atomic_long	last_meal_time;
+	atomic_bool					done;
+}	t_meal_slot;
+
+typedef struct s_opts
+{
+	char				*trace_path;
+	t_lat_mode			latency;
+	t_mon_mode			monitor;
+}	t_opts;
+
+/*
+** Binary trace writer, owned by the parent's log thread.
+*/
+typedef struct s_trace
+{
+	int					fd;
+	int					id_bytes;
+	long				last_ts;
+}	t_trace;
+
+typedef struct s_event
+{
+	long				ts;
+	int					id;
+	int					state;
+}	t_event;
+
+/*
+** One ring slot. seq == position + 1 once the event is published, and
+** position + SHRING_SIZE once the parent has consumed it (Vyukov-style
+** bounded queue).
+*/
+typedef struct s_slot
+{
+	atomic_ulong		seq;
+	t_event				ev;
+}	t_slot;
+
+/*
+** Anonymous MAP_SHARED ring mapped before fork(). Children reserve a
+** position with one fetch_add on tail; only the parent reads it.
+*/
+typedef struct s_shring
+{
+	atomic_ulong		tail;
+	char				pad[56];
+	t_slot				slots[SHRING_SIZE];
+}	t_shring;
+
+/*
+** Parent-side state: the ring, the next position to read, the batch
+** being sorted (its first held events were taken earlier but are newer
+** than limit, so they wait for a later drain), the drain thread and its
+** output buffer.
+*/
+typedef struct s_logger
+{
+	t_shring			*ring;
+	unsigned long		head;
+	t_event				*batch;
+	int					held;
+	long				limit;
+	pthread_t			thread;
+	bool				running;
+	atomic_bool			stop;
+	bool				death_seen;
+	char				*buf;
+	size_t				len;
+}	t_logger;
+
+/*
+** TSC clock state (tsc_bonus.c). seq is a seqlock over base_tsc,
+** base_ns and mult; the cal_* fields are the last calibration point of
+** this process's monitor, the only thread that touches them.
+*/
+typedef struct s_tsc
+{
+	atomic_bool			active;
+	atomic_uint			seq;
+	atomic_ulong		base_tsc;
+	atomic_long			base_ns;
+	atomic_ulong		mult;
+	unsigned long		cal_tsc;
+	long				cal_ns;
+	unsigned long		cal_mult;
+}	t_tsc;
+
+/*
+** Startup sleep calibration (--sleep-calib). The overshoot quantiles and
+** yield latency are what calibrate_sleep() measured; margin_ns and
+** spin_ns are what sleep_until() uses, both 0 when crowded (more
+** philosophers than online CPUs).
+*/
+typedef enum e_calib_mode
+{
+	CAL_AUTO,
+	CAL_OFF,
+	CAL_PRINT
+}	t_calib_mode;
+
+typedef struct s_calib
+{
+	t_calib_mode		mode;
+	long				p50_ns;
+	long				p90_ns;
+	long				max_ns;
+	long				yield_ns;
+	long				margin_ns;
+	long				spin_ns;
+	bool				crowded;
+}	t_calib;
+
+typedef struct s_msg
+{
+	const char			*text;
+	size_t				len;
+}	t_msg;
+
 typedef struct s_philo
 {
 	int					id;
 	int					meals_count;
 	long				last_meal_time;
+	long				deadline;
 	pid_t				pid;
 	pthread_t			monitor;
 	pthread_mutex_t		meal_lock;
 	t_table				*table;
+	char				tag[FMT_TAG_SIZE];
+	size_t				tag_len;
 }	t_philo;
 
 typedef struct s_table
@@ -56,25 +311,58 @@ typedef struct s_table
 	int					must_eat_count;
 	long				start_time;
 	sem_t				*forks;
-	sem_t				*write_sem;
 	sem_t				*dead_sem;
 	t_philo				*philos;
+	t_opts				opts;
+	t_trace				trace;
+	t_logger			log;
+	t_lat_hist			*lat;
+	t_meal_slot			*meals;
+	pthread_t			monitor;
+	bool				monitor_running;
+	atomic_int			monitor_stop;
 }	t_table;
 
+typedef struct s_option
+{
+	const char			*name;
+	bool				takes_value;
+	int					(*apply)(t_table *table, char *value);
+}	t_option;
+
 /* ************************************************************************** */
 /*                           PARSING FUNCTIONS                                */
 /* ************************************************************************** */
 int		validate_args(int argc, char **argv);
 int		ft_atoi_positive(const char *str);
 int		parse_arguments(t_table *table, int argc, char **argv);
+int		parse_options(t_table *table, int *argc, char **argv);
+int		opt_clock(t_table *table, char *value);
+int		opt_sleep_calib(t_table *table, char *value);
 
 /* ************************************************************************** */
 /*                            TIME FUNCTIONS                                  */
 /* ************************************************************************** */
+clockid_t	*time_source(void);
+t_tsc	*tsc_state(void);
+bool	tsc_init(void);
+long	tsc_now_ns(void);
+void	tsc_tick(void);
+long	get_time_ns(void);
+long	get_mono_ns(void);
+long	elapsed_ms(long start_ns);
 long	get_time_ms(void);
 long	elapsed_time(long start_time);
 void	precise_sleep(long duration);
 void	smart_sleep(long duration);
+long	next_deadline(t_philo *philo, long duration);
+void	phase_resync(t_philo *philo, long wait_start);
+void	abs_sleep(long deadline);
+void	sleep_until(long deadline);
+void	phase_sleep(t_philo *philo, long duration);
+t_calib	*sleep_calib(void);
+void	calibrate_sleep(int sleepers);
+void	print_calib(const t_calib *c);
 
 /* ************************************************************************** */
 /*                    INITIALIZATION & CLEANUP FUNCTIONS                      */
@@ -88,8 +376,37 @@ void	cleanup_semaphores(t_table *table);
 /* ************************************************************************** */
 /*                      SYNCHRONIZATION FUNCTIONS                             */
 /* ************************************************************************** */
-void	safe_print(t_philo *philo, char *msg);
 void	announce_death(t_philo *philo);
+const char	*state_msg(t_state state);
+void	log_state(t_philo *philo, t_state state);
+
+/* ************************************************************************** */
+/*                         FORMATTER FUNCTIONS                                */
+/* ************************************************************************** */
+const t_msg	*state_suffix(t_state state);
+size_t	fmt_number(char *dst, long n);
+void	fmt_tag(t_philo *philo);
+size_t	fmt_line(char *dst, long ts, const t_philo *philo, t_state state);
+void	write_all(int fd, const char *buf, size_t len);
+
+/* ************************************************************************** */
+/*                        SHARED LOG RING FUNCTIONS                           */
+/* ************************************************************************** */
+int		open_log(t_table *table);
+void	log_push(t_shring *ring, long start, int id, t_state state);
+void	close_log(t_table *table);
+int		start_logger(t_table *table);
+void	stop_logger(t_table *table);
+int		log_drain(t_table *table, bool final);
+void	log_flush(t_table *table);
+void	*logger_routine(void *arg);
+
+/* ************************************************************************** */
+/*                       BINARY TRACE FUNCTIONS                               */
+/* ************************************************************************** */
+int		open_trace(t_table *table);
+size_t	trace_record(t_trace *trace, unsigned char *dst, const t_event *ev);
+void	close_trace(t_table *table);
 
 /* ************************************************************************** */
 /*                       PHILOSOPHER ACTIONS                                  */
@@ -111,8 +428,19 @@ void	kill_all_processes(t_table *table);
 /* ************************************************************************** */
 /*                         MONITOR FUNCTIONS                                  */
 /* ************************************************************************** */
-bool	is_philosopher_dead(t_philo *philo);
+long	monitor_wake_at(long due, long now, long *woke_for);
 void	*monitor_routine(void *arg);
 int		start_monitor(t_philo *philo);
+int		open_latency(t_table *table);
+void	lat_record(t_lat_hist *h, long gap_ns, bool death);
+void	print_latency(t_table *table);
+void	close_latency(t_table *table);
+int		opt_latency(t_table *table, char *value);
+int		open_meals(t_table *table);
+void	*parent_monitor_routine(void *arg);
+int		start_parent_monitor(t_table *table);
+void	stop_parent_monitor(t_table *table);
+void	close_meals(t_table *table);
+int		opt_monitor(t_table *table, char *value);
 
 #endif
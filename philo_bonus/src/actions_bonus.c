@@ -22,16 +22,21 @@
 **   2. Print "has taken a fork"
 **   3. Wait on forks semaphore again (for second fork)
 **   4. Print "has taken a fork" again
+**   5. Restart the sleep timeline if the forks took long (phase_resync)
 ** 
 ** Semaphore ensures only N forks can be held at once
 ** Single philosopher will deadlock (by design, as in mandatory part)
 */
 void	take_forks(t_philo *philo)
 {
+	long	wait_start;
+
+	wait_start = get_mono_ns();
 	sem_wait(philo->table->forks);
-	safe_print(philo, "has taken a fork");
+	log_state(philo, ST_FORK);
 	sem_wait(philo->table->forks);
-	safe_print(philo, "has taken a fork");
+	log_state(philo, ST_FORK);
+	phase_resync(philo, wait_start);
 }
 
 /*
@@ -43,18 +48,25 @@ void	take_forks(t_philo *philo)
 **   1. Print "is eating" message
 **   2. Update last_meal_time to current time
 **   3. Increment meals_count
-**   4. Sleep for time_to_eat duration
+**   4. With --monitor parent, publish the meal time to the shared table
+**   5. Sleep until the time_to_eat deadline (phase_sleep)
 ** 
 ** Note: last_meal_time is local to process, no mutex needed
 */
 void	eat_action(t_philo *philo)
 {
-	safe_print(philo, "is eating");
+	long	now;
+
+	log_state(philo, ST_EAT);
+	now = get_time_ns();
 	pthread_mutex_lock(&philo->meal_lock);
-	philo->last_meal_time = get_time_ms();
+	philo->last_meal_time = now;
 	philo->meals_count++;
 	pthread_mutex_unlock(&philo->meal_lock);
-	smart_sleep(philo->table->time_to_eat);
+	if (philo->table->meals)
+		atomic_store_explicit(&philo->table->meals[philo->id - 1]
+			.last_meal_time, now, memory_order_release);
+	phase_sleep(philo, philo->table->time_to_eat);
 }
 
 /*
@@ -85,8 +97,8 @@ void	drop_forks(t_philo *philo)
 */
 void	sleep_action(t_philo *philo)
 {
-	safe_print(philo, "is sleeping");
-	smart_sleep(philo->table->time_to_sleep);
+	log_state(philo, ST_SLEEP);
+	phase_sleep(philo, philo->table->time_to_sleep);
 }
 
 /*
@@ -104,7 +116,7 @@ void	think_action(t_philo *philo)
 {
 	long	think_time;
 
-	safe_print(philo, "is thinking");
+	log_state(philo, ST_THINK);
 	if (philo->table->philo_count % 2 != 0)
 	{
 		think_time = (philo->table->time_to_eat * 2)
@@ -114,6 +126,6 @@ void	think_action(t_philo *philo)
 		if (think_time > 600)
 			think_time = 200;
 		if (think_time > 0)
-			usleep(think_time * 1000);
+			phase_sleep(philo, think_time);
 	}
 }
@@ -30,11 +30,6 @@ void	cleanup_semaphores(t_table *table)
 		sem_close(table->forks);
 		sem_unlink("/forks");
 	}
-	if (table->write_sem)
-	{
-		sem_close(table->write_sem);
-		sem_unlink("/write");
-	}
 	if (table->dead_sem)
 	{
 		sem_close(table->dead_sem);
@@ -50,6 +45,8 @@ void	cleanup_semaphores(t_table *table)
 ** Implementation:
 **   1. Free philosopher array
 **   2. Clean up semaphores
+**   3. Unmap the shared log ring, --latency histogram and meal table,
+**      and close the --trace-bin file
 ** 
 ** Called at program exit
 */
@@ -58,4 +55,8 @@ void	cleanup_table(t_table *table)
 	if (table->philos)
 		free(table->philos);
 	cleanup_semaphores(table);
+	close_log(table);
+	close_trace(table);
+	close_latency(table);
+	close_meals(table);
 }
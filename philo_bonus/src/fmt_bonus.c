@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   fmt_bonus.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo_bonus.h"
+
+/*
+** @brief: Returns the two-digit lookup table "00" .. "99"
+** @param: void
+** @return: 200-character table, digits of n at offset n * 2
+*/
+static const char	*digit_pairs(void)
+{
+	static const char	pairs[] = "00010203040506070809"
+		"10111213141516171819" "20212223242526272829"
+		"30313233343536373839" "40414243444546474849"
+		"50515253545556575859" "60616263646566676869"
+		"70717273747576777879" "80818283848586878889"
+		"90919293949596979899";
+
+	return (pairs);
+}
+
+/*
+** @brief: Table-driven integer to ASCII conversion
+** @param: dst - destination (at least 20 bytes), n - number (< 0 = 0)
+** @return: number of characters written
+**
+** Emits two digits per division using digit_pairs(), filling a scratch
+** buffer from the end so no reversal pass is needed.
+*/
+size_t	fmt_number(char *dst, long n)
+{
+	char		tmp[24];
+	const char	*pairs;
+	int			pos;
+
+	pairs = digit_pairs();
+	if (n < 0)
+		n = 0;
+	pos = 24;
+	while (n >= 100)
+	{
+		pos -= 2;
+		memcpy(tmp + pos, pairs + (n % 100) * 2, 2);
+		n /= 100;
+	}
+	if (n >= 10)
+	{
+		pos -= 2;
+		memcpy(tmp + pos, pairs + n * 2, 2);
+	}
+	else
+		tmp[--pos] = '0' + n;
+	memcpy(dst, tmp + pos, 24 - pos);
+	return (24 - pos);
+}
+
+/*
+** @brief: Builds a philosopher's " <id> " fragment once at init
+** @param: philo - philosopher whose id is already set
+** @return: void
+*/
+void	fmt_tag(t_philo *philo)
+{
+	philo->tag[0] = ' ';
+	philo->tag_len = 1 + fmt_number(philo->tag + 1, philo->id);
+	philo->tag[philo->tag_len++] = ' ';
+}
+
+/*
+** @brief: Formats "timestamp id message\n" without printf
+** @param: dst - destination (at least FMT_LINE_MAX bytes)
+** @param: ts - timestamp in ms, philo - author, state - state code
+** @return: line length
+**
+** Only the timestamp is converted per line; the tag and the suffix are
+** copied from precomputed buffers.
+*/
+size_t	fmt_line(char *dst, long ts, const t_philo *philo, t_state state)
+{
+	const t_msg	*suffix;
+	size_t		len;
+
+	suffix = state_suffix(state);
+	len = fmt_number(dst, ts);
+	memcpy(dst + len, philo->tag, philo->tag_len);
+	len += philo->tag_len;
+	memcpy(dst + len, suffix->text, suffix->len);
+	return (len + suffix->len);
+}
+
+/*
+** @brief: Returns the line suffix of a state, newline included
+** @param: state - state code
+** @return: suffix with its precomputed length
+**
+** Lengths come from sizeof at compile time, so the formatter never
+** calls strlen() on the hot path.
+*/
+const t_msg	*state_suffix(t_state state)
+{
+	static const t_msg	suffixes[] = {
+	{"has taken a fork\n", sizeof("has taken a fork\n") - 1},
+	{"is eating\n", sizeof("is eating\n") - 1},
+	{"is sleeping\n", sizeof("is sleeping\n") - 1},
+	{"is thinking\n", sizeof("is thinking\n") - 1},
+	{"died\n", sizeof("died\n") - 1}
+	};
+
+	return (&suffixes[state]);
+}
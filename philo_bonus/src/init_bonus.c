@@ -20,8 +20,9 @@
 ** Implementation:
 **   1. Unlink any existing semaphores with same names
 **   2. Create forks semaphore (value = philo_count)
-**   3. Create write semaphore for output (value = 1)
-**   4. Create dead semaphore for death signaling (value = 0)
+**   3. Create dead semaphore for death signaling (value = 0)
+** 
+** Output needs no semaphore: it goes through the shared log ring.
 ** 
 ** Semaphore names must be unique and start with /
 ** Forks semaphore acts as counting semaphore (multiple forks available)
@@ -29,7 +30,6 @@
 int	init_semaphores(t_table *table)
 {
 	sem_unlink("/forks");
-	sem_unlink("/write");
 	sem_unlink("/dead");
 	table->forks = sem_open("/forks", O_CREAT | O_EXCL, 0644,
 			table->philo_count);
@@ -38,18 +38,12 @@ int	init_semaphores(t_table *table)
 		printf("Error: Failed to create forks semaphore\n");
 		return (1);
 	}
-	table->write_sem = sem_open("/write", O_CREAT | O_EXCL, 0644, 1);
-	if (table->write_sem == SEM_FAILED)
-	{
-		printf("Error: Failed to create write semaphore\n");
-		sem_close(table->forks);
-		sem_unlink("/forks");
-		return (1);
-	}
 	table->dead_sem = sem_open("/dead", O_CREAT | O_EXCL, 0644, 0);
 	if (table->dead_sem == SEM_FAILED)
 	{
 		printf("Error: Failed to create dead semaphore\n");
+		sem_close(table->forks);
+		sem_unlink("/forks");
 		return (1);
 	}
 	return (0);
@@ -64,6 +58,7 @@ int	init_semaphores(t_table *table)
 **   1. Allocate array of philosophers
 **   2. Initialize each philosopher's data
 **   3. Set table reference in each philosopher
+**   4. Build the " <id> " output tag used by the formatter
 ** 
 ** Note: PIDs will be set when processes are forked
 */
@@ -83,8 +78,10 @@ int	init_philosophers(t_table *table)
 		table->philos[i].id = i + 1;
 		table->philos[i].meals_count = 0;
 		table->philos[i].last_meal_time = 0;
+		table->philos[i].deadline = 0;
 		table->philos[i].pid = 0;
 		table->philos[i].table = table;
+		fmt_tag(&table->philos[i]);
 		i++;
 	}
 	return (0);
@@ -104,7 +101,7 @@ int	init_philosophers(t_table *table)
 */
 int	init_table(t_table *table)
 {
-	table->start_time = get_time_ms();
+	table->start_time = get_time_ns();
 	if (init_semaphores(table) != 0)
 		return (1);
 	if (init_philosophers(table) != 0)
@@ -0,0 +1,178 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   latency_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo_bonus.h"
+
+/*
+** @brief: Maps the shared latency histogram (--latency only)
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+**
+** Must run before create_processes(), like open_log(): the children
+** inherit the MAP_SHARED mapping and record into the parent's copy.
+*/
+int	open_latency(t_table *table)
+{
+	void	*map;
+
+	if (table->opts.latency == LAT_OFF)
+		return (0);
+	map = mmap(NULL, sizeof(t_lat_hist), PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (map == MAP_FAILED)
+		return (printf("Error: Failed to map latency histogram\n"), 1);
+	table->lat = map;
+	return (0);
+}
+
+/*
+** @brief: Adds one detection gap to the shared histogram (child side)
+** @param: h - shared histogram
+** @param: gap_ns - announcement time minus the real deadline
+** @param: death - true for a death, false for a near-miss
+** @return: void
+*/
+void	lat_record(t_lat_hist *h, long gap_ns, bool death)
+{
+	unsigned long	us;
+	long			max;
+	int				k;
+
+	if (gap_ns < 0)
+		gap_ns = 0;
+	us = gap_ns / 1000;
+	k = 0;
+	if (us > 0)
+		k = 64 - __builtin_clzl(us);
+	if (k >= LAT_BUCKETS)
+		k = LAT_BUCKETS - 1;
+	atomic_fetch_add_explicit(&h->buckets[k], 1, memory_order_relaxed);
+	if (death)
+		atomic_fetch_add_explicit(&h->deaths, 1, memory_order_relaxed);
+	else
+		atomic_fetch_add_explicit(&h->near_misses, 1, memory_order_relaxed);
+	if (gap_ns > LAT_SLA_NS)
+		atomic_fetch_add_explicit(&h->over_sla, 1, memory_order_relaxed);
+	max = atomic_load_explicit(&h->max_ns, memory_order_relaxed);
+	while (gap_ns > max && !atomic_compare_exchange_weak(&h->max_ns, &max,
+			gap_ns))
+		;
+}
+
+/*
+** @brief: Upper bound of the bucket holding a quantile
+** @param: b - bucket counts, total - sample count, per_mille - quantile
+** @return: bucket upper bound in us (-1 for the open last bucket)
+*/
+static long	quantile_us(const unsigned long *b, unsigned long total,
+	int per_mille)
+{
+	unsigned long	seen;
+	int				k;
+
+	seen = 0;
+	k = 0;
+	while (k < LAT_BUCKETS - 1)
+	{
+		seen += b[k];
+		if (seen * 1000 >= total * per_mille)
+			return (1L << k);
+		k++;
+	}
+	return (-1);
+}
+
+/*
+** @brief: Prints the latency histogram for operators (--latency)
+** @param: table - pointer to table structure (children reaped)
+** @return: void
+**
+** Same report as philo's, on stderr so stdout stays clean. Only
+** non-empty buckets are listed; quantiles are bucket upper bounds.
+*/
+void	print_latency(t_table *table)
+{
+	unsigned long	b[LAT_BUCKETS];
+	unsigned long	total;
+	unsigned long	peak;
+	int				k;
+
+	if (!table->lat)
+		return ;
+	total = 0;
+	peak = 1;
+	k = -1;
+	while (++k < LAT_BUCKETS)
+	{
+		b[k] = atomic_load(&table->lat->buckets[k]);
+		total += b[k];
+		if (b[k] > peak)
+			peak = b[k];
+	}
+	fprintf(stderr, "death detection latency (%lu deaths, %lu near-misses)\n",
+		atomic_load(&table->lat->deaths),
+		atomic_load(&table->lat->near_misses));
+	if (total == 0)
+		return ;
+	fprintf(stderr, "  p50 < %ldus  p99 < %ldus  max %ldus  over %ldms: %lu\n",
+		quantile_us(b, total, 500), quantile_us(b, total, 990),
+		atomic_load(&table->lat->max_ns) / 1000, LAT_SLA_NS / NS_PER_MS,
+		atomic_load(&table->lat->over_sla));
+	k = -1;
+	while (++k < LAT_BUCKETS)
+	{
+		if (b[k] == 0)
+			continue ;
+		fprintf(stderr, "  [%6ld, ", (k > 0) * (1L << (k - 1)));
+		if (k < LAT_BUCKETS - 1)
+			fprintf(stderr, "%6ld) us", 1L << k);
+		else
+			fprintf(stderr, "   inf) us");
+		fprintf(stderr, " %8lu %.*s\n", b[k], (int)(b[k] * 40 / peak),
+			"########################################");
+	}
+}
+
+/*
+** @brief: Unmaps the shared latency histogram
+** @param: table - pointer to table structure
+** @return: void
+*/
+void	close_latency(t_table *table)
+{
+	if (!table->lat)
+		return ;
+	munmap(table->lat, sizeof(t_lat_hist));
+	table->lat = NULL;
+}
+
+/*
+** @brief: Selects what the death detection latency report samples
+** @param: table - pointer to table structure
+** @param: value - "off", "deaths" or "all" (deaths and near-misses)
+** @return: 0 on success, 1 on unknown mode
+*/
+int	opt_latency(t_table *table, char *value)
+{
+	if (strcmp(value, "off") == 0)
+		table->opts.latency = LAT_OFF;
+	else if (strcmp(value, "deaths") == 0)
+		table->opts.latency = LAT_DEATHS;
+	else if (strcmp(value, "all") == 0)
+		table->opts.latency = LAT_ALL;
+	else
+	{
+		printf("Error: Unknown --latency %s\n", value);
+		return (1);
+	}
+	return (0);
+}
@@ -0,0 +1,177 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log_writer_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo_bonus.h"
+
+/*
+** @brief: Moves published events out of the shared ring
+** @param: log - parent-side logger
+** @param: batch - destination (max events), final - true once every
+**         child has exited
+** @return: number of events taken
+**
+** Takes everything published, up to the first slot that is not, so
+** positions are consumed strictly in order. In the final pass a slot
+** reserved by a child that was killed before publishing is skipped
+** instead.
+*/
+static int	take_batch(t_logger *log, t_event *batch, int max, bool final)
+{
+	unsigned long	tail;
+	t_slot			*slot;
+	int				n;
+
+	tail = atomic_load(&log->ring->tail);
+	n = 0;
+	while (n < max)
+	{
+		slot = &log->ring->slots[log->head & (SHRING_SIZE - 1)];
+		if (atomic_load_explicit(&slot->seq, memory_order_acquire)
+			== log->head + 1)
+			batch[n++] = slot->ev;
+		else if (!final || log->head >= tail)
+			break ;
+		atomic_store_explicit(&slot->seq, log->head + SHRING_SIZE,
+			memory_order_release);
+		log->head++;
+	}
+	return (n);
+}
+
+/*
+** @brief: Stable insertion sort of a batch by timestamp
+** @param: batch - held events, then new ones in reservation order
+** @param: n - number of events
+** @return: void
+**
+** The batch is almost always sorted already, so this is close to one
+** linear pass; a late event only moves past those stamped before it.
+*/
+static void	sort_batch(t_event *batch, int n)
+{
+	t_event	tmp;
+	int		i;
+	int		j;
+
+	i = 1;
+	while (i < n)
+	{
+		tmp = batch[i];
+		j = i - 1;
+		while (j >= 0 && batch[j].ts > tmp.ts)
+		{
+			batch[j + 1] = batch[j];
+			j--;
+		}
+		batch[j + 1] = tmp;
+		i++;
+	}
+}
+
+/*
+** @brief: Formats one event into the output buffer
+** @param: table - pointer to table structure, ev - event
+** @return: void
+**
+** Text line, or binary record with --trace-bin. Nothing is emitted
+** after the first death, even if another child reported one too.
+*/
+static void	emit_event(t_table *table, const t_event *ev)
+{
+	t_logger	*log;
+
+	log = &table->log;
+	if (log->death_seen)
+		return ;
+	if (log->len + FMT_LINE_MAX > LOG_BATCH_SIZE)
+		log_flush(table);
+	if (table->opts.trace_path)
+		log->len += trace_record(&table->trace,
+				(unsigned char *)log->buf + log->len, ev);
+	else
+		log->len += fmt_line(log->buf + log->len, ev->ts,
+				&table->philos[ev->id - 1], ev->state);
+	log->death_seen = (ev->state == ST_DIED);
+}
+
+/*
+** @brief: Takes, orders and writes one batch of events
+** @param: table - pointer to table structure
+** @param: final - true once every child has exited
+** @return: number of events taken
+**
+** Implementation:
+**   1. Read the clock, then tail: every slot reserved after that is
+**      stamped at now or later
+**   2. Take the published events behind the held ones and sort them all
+**   3. If the take reached that tail (no slot was reserved but still
+**      unpublished), nothing can come later stamped before now, so
+**      limit moves to now. Otherwise limit stays where it was: a
+**      preempted child may still publish anything stamped since then
+**   4. Write the events stamped up to limit (everything in the final
+**      pass) and hold the rest for the next drain
+**
+** now is taken one ms early: children stamp with their own TSC
+** calibration (--clock tsc), which may lag the parent's a little. If
+** the held events fill the batch, they are written anyway.
+*/
+int	log_drain(t_table *table, bool final)
+{
+	t_logger		*log;
+	unsigned long	tail;
+	long			now;
+	int				n;
+	int				i;
+
+	log = &table->log;
+	now = elapsed_ms(table->start_time) - 1;
+	tail = atomic_load(&log->ring->tail);
+	n = take_batch(log, log->batch + log->held, SHRING_SIZE - log->held,
+			final);
+	sort_batch(log->batch, log->held + n);
+	if (log->head >= tail)
+		log->limit = now;
+	log->held += n;
+	i = 0;
+	while (i < log->held && (final || log->batch[i].ts <= log->limit))
+		emit_event(table, &log->batch[i++]);
+	if (i == 0 && log->held == SHRING_SIZE)
+		while (i < log->held)
+			emit_event(table, &log->batch[i++]);
+	log->held -= i;
+	memmove(log->batch, log->batch + i, sizeof(t_event) * log->held);
+	log_flush(table);
+	return (n);
+}
+
+/*
+** @brief: Parent log thread: drains the shared ring until stopped
+** @param: arg - pointer to table structure
+** @return: NULL
+**
+** Polls every 0.5 ms when the ring is empty, then does the final
+** passes once stop_logger() has been called.
+*/
+void	*logger_routine(void *arg)
+{
+	t_table	*table;
+
+	table = (t_table *)arg;
+	while (!atomic_load(&table->log.stop))
+	{
+		if (log_drain(table, false) == 0)
+			usleep(500);
+	}
+	while (log_drain(table, true) > 0)
+		;
+	return (NULL);
+}
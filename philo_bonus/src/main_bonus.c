@@ -18,10 +18,14 @@
 ** @return: 0 on success, 1 on error
 ** 
 ** Implementation:
-**   1. Parse and validate arguments
-**   2. Initialize table and semaphores
-**   3. Fork all philosopher processes
-**   4. Wait for death or completion
+**   1. Parse options and validate arguments, calibrate the sleeper
+**      (inherited by every child)
+**   2. Initialize table and semaphores, the --trace-bin file, the
+**      shared log ring, the --latency histogram and the meal table
+**   3. Start the log thread, fork all philosopher processes, then
+**      start the --monitor parent thread
+**   4. Wait for death or completion, stop the monitor, then drain the
+**      log and print the --latency report
 **   5. Clean up resources
 ** 
 ** Bonus part uses processes instead of threads
@@ -33,16 +37,25 @@ int	main(int argc, char **argv)
 	t_table	table;
 
 	memset(&table, 0, sizeof(t_table));
-	if (parse_arguments(&table, argc, argv) != 0)
+	if (parse_options(&table, &argc, argv) != 0
+		|| parse_arguments(&table, argc, argv) != 0)
 		return (1);
+	calibrate_sleep(table.philo_count);
 	if (init_table(&table) != 0)
 		return (1);
-	if (create_processes(&table) != 0)
+	if (open_trace(&table) != 0 || open_log(&table) != 0
+		|| open_latency(&table) != 0 || open_meals(&table) != 0
+		|| start_logger(&table) != 0 || create_processes(&table) != 0
+		|| start_parent_monitor(&table) != 0)
 	{
+		stop_logger(&table);
 		cleanup_table(&table);
 		return (1);
 	}
 	wait_processes(&table);
+	stop_parent_monitor(&table);
+	stop_logger(&table);
+	print_latency(&table);
 	cleanup_table(&table);
 	return (0);
 }
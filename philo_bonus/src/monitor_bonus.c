@@ -13,28 +13,39 @@
 #include "../include/philo_bonus.h"
 
 /*
-** @brief: Check if philosopher has died
-** @param: philo - pointer to philosopher to check
-** @return: true if dead, false otherwise
-** 
-** Implementation:
-**   1. Get current time
-**   2. Calculate time since last meal
-**   3. Compare with time_to_die
-** 
-** No mutex needed - each process monitors only itself
-** last_meal_time is local to this process
+** @brief: Time at which this process's philosopher dies if it does not eat
+** @param: philo - pointer to philosopher
+** @return: last_meal_time + time_to_die, in ns
 */
-bool	is_philosopher_dead(t_philo *philo)
+static long	death_due(t_philo *philo)
 {
-	long	current_time;
-	long	time_since_meal;
+	long	due;
 
 	pthread_mutex_lock(&philo->meal_lock);
-	current_time = get_time_ms();
-	time_since_meal = current_time - philo->last_meal_time;
+	due = philo->last_meal_time + philo->table->time_to_die * NS_PER_MS;
 	pthread_mutex_unlock(&philo->meal_lock);
-	return (time_since_meal >= philo->table->time_to_die);
+	return (due);
+}
+
+/*
+** @brief: Picks when a monitor wakes up next
+** @param: due - earliest deadline, now - current time (get_time_ns())
+** @param: woke_for - set to due when sleeping until it, 0 otherwise
+** @return: wake-up time on the get_time_ns() timeline
+**
+** Sleeps until the deadline, or for TSC_RECAL_NS if that is further
+** away, so the TSC clock can recalibrate (tsc_tick()). Shared with the
+** parent monitor.
+*/
+long	monitor_wake_at(long due, long now, long *woke_for)
+{
+	if (due - now <= TSC_RECAL_NS)
+	{
+		*woke_for = due;
+		return (due);
+	}
+	*woke_for = 0;
+	return (now + TSC_RECAL_NS);
 }
 
 /*
@@ -44,27 +55,46 @@ bool	is_philosopher_dead(t_philo *philo)
 ** 
 ** Implementation:
 **   1. Cast arg to t_philo*
-**   2. Loop: check if philosopher is dead
-**   3. If dead: announce death and exit process
-**   4. If all meals eaten: exit process successfully
-**   5. Sleep ~2ms before next check
+**   2. Loop: read the death deadline (last_meal_time + time_to_die)
+**   3. If it has passed: announce death and exit process
+**   4. Otherwise sleep until it (abs_sleep()), at most TSC_RECAL_NS so
+**      the TSC clock can recalibrate once a second (monitor_wake_at())
+**   5. With --latency, record how late the death was announced, or
+**      (all) how late a wake-up for a deadline the philosopher then
+**      beat came: woke_for is that deadline, 0 after a capped sleep
 ** 
 ** Each process has its own monitor thread
 ** Monitors only the local philosopher
+** A meal only moves the deadline later, so the monitor never needs to
+** be woken early: it wakes at the old deadline, sees the meal, and goes
+** back to sleep until the new one.
 */
 void	*monitor_routine(void *arg)
 {
 	t_philo	*philo;
+	long	due;
+	long	now;
+	long	woke_for;
+	long	wake;
 
 	philo = (t_philo *)arg;
+	woke_for = 0;
 	while (1)
 	{
-		usleep(2000);
-		if (is_philosopher_dead(philo))
+		due = death_due(philo);
+		now = get_time_ns();
+		if (due <= now)
 		{
 			announce_death(philo);
+			if (philo->table->lat)
+				lat_record(philo->table->lat, get_time_ns() - due, true);
 			exit(1);
 		}
+		if (woke_for && philo->table->opts.latency == LAT_ALL)
+			lat_record(philo->table->lat, now - woke_for, false);
+		tsc_tick();
+		wake = monitor_wake_at(due, now, &woke_for);
+		abs_sleep(get_mono_ns() + (wake - now));
 	}
 	return (NULL);
 }
@@ -0,0 +1,116 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo_bonus.h"
+
+/*
+** @brief: Writes binary event records to a file instead of text
+** @param: table - pointer to table structure, value - trace file path
+** @return: 0
+*/
+static int	opt_trace_bin(t_table *table, char *value)
+{
+	table->opts.trace_path = value;
+	return (0);
+}
+
+/*
+** @brief: Looks up an option descriptor by name
+** @param: name - option as typed on the command line ("--name")
+** @return: matching descriptor, or NULL if unknown
+**
+** New options are added by appending a row to the table below.
+*/
+static const t_option	*find_option(const char *name)
+{
+	static const t_option	options[] = {
+	{"--trace-bin", true, opt_trace_bin},
+	{"--clock", true, opt_clock},
+	{"--sleep-calib", true, opt_sleep_calib},
+	{"--latency", true, opt_latency},
+	{"--monitor", true, opt_monitor},
+	{NULL, false, NULL}
+	};
+	int						i;
+
+	i = 0;
+	while (options[i].name)
+	{
+		if (strcmp(options[i].name, name) == 0)
+			return (&options[i]);
+		i++;
+	}
+	return (NULL);
+}
+
+/*
+** @brief: Applies one "--option [value]" found at argv[i]
+** @param: table - pointer to table structure, argv - argument array
+** @param: i - index of the option in argv
+** @return: number of argv entries consumed, -1 on error
+*/
+static int	apply_option(t_table *table, char **argv, int i)
+{
+	const t_option	*opt;
+
+	opt = find_option(argv[i]);
+	if (!opt)
+	{
+		printf("Error: Unknown option %s\n", argv[i]);
+		return (-1);
+	}
+	if (opt->takes_value && !argv[i + 1])
+	{
+		printf("Error: Option %s requires a value\n", argv[i]);
+		return (-1);
+	}
+	if (opt->apply(table, argv[i + 1]) != 0)
+		return (-1);
+	return (1 + opt->takes_value);
+}
+
+/*
+** @brief: Extracts "--option" flags from the argument vector
+** @param: table - pointer to table structure, argc/argv - arguments
+** @return: 0 on success, 1 on error
+**
+** Implementation:
+**   1. Walk argv, handing every "--xxx" entry to apply_option()
+**   2. Compact the remaining positional arguments in place
+**   3. Update argc so parse_arguments() only sees the mandatory ones
+**
+** Options may appear anywhere on the command line.
+*/
+int	parse_options(t_table *table, int *argc, char **argv)
+{
+	int	i;
+	int	j;
+	int	used;
+
+	i = 1;
+	j = 1;
+	while (i < *argc)
+	{
+		if (argv[i][0] == '-' && argv[i][1] == '-')
+		{
+			used = apply_option(table, argv, i);
+			if (used < 0)
+				return (1);
+			i += used;
+		}
+		else
+			argv[j++] = argv[i++];
+	}
+	argv[j] = NULL;
+	*argc = j;
+	return (0);
+}
@@ -0,0 +1,236 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   parent_monitor_bonus.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo_bonus.h"
+
+/*
+** @brief: Maps the shared meal table (--monitor parent only)
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+**
+** Must run before create_processes(), like open_log(): every child
+** publishes into the parent's copy. All slots start at start_time,
+** which is also where each child's own last_meal_time starts.
+*/
+int	open_meals(t_table *table)
+{
+	void	*map;
+	int		i;
+
+	if (table->opts.monitor == MON_CHILD)
+		return (0);
+	map = mmap(NULL, sizeof(t_meal_slot) * table->philo_count,
+			PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (map == MAP_FAILED)
+		return (printf("Error: Failed to map meal table\n"), 1);
+	table->meals = map;
+	i = 0;
+	while (i < table->philo_count)
+	{
+		atomic_init(&table->meals[i].last_meal_time, table->start_time);
+		atomic_init(&table->meals[i].done, false);
+		i++;
+	}
+	return (0);
+}
+
+/*
+** @brief: Earliest death deadline among the philosophers still eating
+** @param: table - pointer to table structure
+** @param: who - set to the index of that philosopher, -1 if all are done
+** @return: last_meal_time + time_to_die of philos[*who], in ns
+*/
+static long	earliest_due(t_table *table, int *who)
+{
+	long	due;
+	long	min;
+	int		i;
+
+	*who = -1;
+	min = LONG_MAX;
+	i = 0;
+	while (i < table->philo_count)
+	{
+		if (!atomic_load_explicit(&table->meals[i].done, memory_order_acquire))
+		{
+			due = atomic_load_explicit(&table->meals[i].last_meal_time,
+					memory_order_acquire)
+				+ table->time_to_die * NS_PER_MS;
+			if (due < min)
+			{
+				min = due;
+				*who = i;
+			}
+		}
+		i++;
+	}
+	return (min);
+}
+
+/*
+** @brief: Announces a death from the parent and ends the simulation
+** @param: table - pointer to table structure
+** @param: who - index of the philosopher that died
+** @param: due - its death deadline
+** @return: void
+**
+** The death goes straight into the log ring and the children are
+** killed right here: no dead_sem post and no child exit status on the
+** way. Only the main thread reaps, in wait_processes().
+*/
+static void	parent_announce(t_table *table, int who, long due)
+{
+	int	i;
+
+	log_push(table->log.ring, table->start_time, who + 1, ST_DIED);
+	if (table->lat)
+		lat_record(table->lat, get_time_ns() - due, true);
+	i = 0;
+	while (i < table->philo_count)
+		kill(table->philos[i++].pid, SIGKILL);
+}
+
+/*
+** @brief: Sleeps until a deadline or stop_parent_monitor()
+** @param: table - pointer to table structure
+** @param: at - wake-up time on the get_time_ns() timeline
+** @return: void
+**
+** Same futex wait as philo's monitor_wait(): absolute CLOCK_MONOTONIC
+** timeout, converted as a distance from now for the coarse/TSC clocks.
+*/
+static void	parent_wait(t_table *table, long at)
+{
+	struct timespec	ts;
+	long			until;
+
+	until = get_mono_ns() + (at - get_time_ns());
+	ts.tv_sec = until / NS_PER_SEC;
+	ts.tv_nsec = until % NS_PER_SEC;
+	syscall(SYS_futex, &table->monitor_stop, FUTEX_WAIT_BITSET_PRIVATE, 0,
+		&ts, NULL, FUTEX_BITSET_MATCH_ANY);
+}
+
+/*
+** @brief: Parent monitor thread: watches every philosopher's deadline
+** @param: arg - pointer to table structure (void* cast)
+** @return: NULL
+**
+** Implementation:
+**   1. Find the earliest deadline in the shared meal table
+**   2. Return once every philosopher is done (must_eat reached)
+**   3. If it has passed: announce the death, kill everyone, return
+**   4. Otherwise sleep until it, at most TSC_RECAL_NS (tsc_tick(),
+**      monitor_wake_at())
+**   5. With --latency all, a wake-up that finds the deadline it slept
+**      for already beaten is a near-miss, as in monitor_routine()
+**
+** One thread and one clock decide every death, instead of one monitor
+** thread per child.
+*/
+void	*parent_monitor_routine(void *arg)
+{
+	t_table	*table;
+	long	due;
+	long	now;
+	long	woke_for;
+	int		who;
+
+	table = (t_table *)arg;
+	woke_for = 0;
+	while (!atomic_load_explicit(&table->monitor_stop, memory_order_acquire))
+	{
+		due = earliest_due(table, &who);
+		if (who < 0)
+			return (NULL);
+		now = get_time_ns();
+		if (due <= now)
+			return (parent_announce(table, who, due), NULL);
+		if (woke_for && table->opts.latency == LAT_ALL)
+			lat_record(table->lat, now - woke_for, false);
+		tsc_tick();
+		parent_wait(table, monitor_wake_at(due, now, &woke_for));
+	}
+	return (NULL);
+}
+
+/*
+** @brief: Starts the parent monitor (--monitor parent only)
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+**
+** Called once every child is forked, so the thread never sees a slot
+** that has no process behind it.
+*/
+int	start_parent_monitor(t_table *table)
+{
+	if (!table->meals)
+		return (0);
+	if (pthread_create(&table->monitor, NULL, parent_monitor_routine,
+			table) != 0)
+	{
+		printf("Error: Failed to create monitor thread\n");
+		kill_all_processes(table);
+		return (1);
+	}
+	table->monitor_running = true;
+	return (0);
+}
+
+/*
+** @brief: Wakes and joins the parent monitor
+** @param: table - pointer to table structure (children reaped)
+** @return: void
+*/
+void	stop_parent_monitor(t_table *table)
+{
+	if (!table->monitor_running)
+		return ;
+	atomic_store_explicit(&table->monitor_stop, 1, memory_order_release);
+	syscall(SYS_futex, &table->monitor_stop, FUTEX_WAKE_PRIVATE, 1, NULL,
+		NULL, 0);
+	pthread_join(table->monitor, NULL);
+	table->monitor_running = false;
+}
+
+/*
+** @brief: Unmaps the shared meal table
+** @param: table - pointer to table structure
+** @return: void
+*/
+void	close_meals(t_table *table)
+{
+	if (!table->meals)
+		return ;
+	munmap(table->meals, sizeof(t_meal_slot) * table->philo_count);
+	table->meals = NULL;
+}
+
+/*
+** @brief: Selects who detects deaths
+** @param: table - pointer to table structure
+** @param: value - "child" (a monitor thread per process) or "parent"
+** @return: 0 on success, 1 on unknown mode
+*/
+int	opt_monitor(t_table *table, char *value)
+{
+	if (strcmp(value, "child") == 0)
+		table->opts.monitor = MON_CHILD;
+	else if (strcmp(value, "parent") == 0)
+		table->opts.monitor = MON_PARENT;
+	else
+	{
+		printf("Error: Unknown --monitor %s\n", value);
+		return (1);
+	}
+	return (0);
+}
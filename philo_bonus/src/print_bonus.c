@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   print_bonus.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo_bonus.h"
+
+/*
+** @brief: Writes a whole buffer, retrying on short writes
+** @param: fd - destination, buf - data, len - byte count
+** @return: void
+*/
+void	write_all(int fd, const char *buf, size_t len)
+{
+	ssize_t	ret;
+
+	while (len > 0)
+	{
+		ret = write(fd, buf, len);
+		if (ret <= 0)
+			return ;
+		buf += ret;
+		len -= ret;
+	}
+}
+
+/*
+** @brief: Writes the parent's output buffer with one write(2)
+** @param: table - pointer to table structure
+** @return: void
+**
+** Text goes to stdout, binary records to the --trace-bin file.
+*/
+void	log_flush(t_table *table)
+{
+	if (table->log.len == 0)
+		return ;
+	if (table->opts.trace_path)
+		write_all(table->trace.fd, table->log.buf, table->log.len);
+	else
+		write_all(STDOUT_FILENO, table->log.buf, table->log.len);
+	table->log.len = 0;
+}
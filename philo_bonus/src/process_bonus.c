@@ -18,26 +18,33 @@
 ** @return: void (exits process)
 ** 
 ** Implementation:
-**   1. Initialize last_meal_time
-**   2. Start monitor thread for death detection
+**   1. Ask to be killed if the parent dies, initialize last_meal_time
+**   2. Start monitor thread for death detection, unless the parent
+**      monitors (--monitor parent): then recalibrate the TSC clock
+**      once per cycle instead, since no monitor does it here
 **   3. Main loop: take_forks -> eat -> drop -> sleep -> think
-**   4. Exit when monitor detects death or meal completion
+**   4. Exit when monitor detects death or meal completion (marking
+**      the shared slot done first, so the parent stops watching)
 ** 
 ** This function runs in a child process
 ** Each philosopher is completely independent
+** Only the parent writes output, so a parent killed by SIGPIPE (e.g.
+** "| head") must take the children with it: otherwise they would fill
+** the shared log ring and block in it forever.
 */
 void	philosopher_process(t_philo *philo)
 {
-	if (pthread_mutex_init(&philo->meal_lock, NULL) != 0)
+	prctl(PR_SET_PDEATHSIG, SIGKILL);
+	if (getppid() == 1 || pthread_mutex_init(&philo->meal_lock, NULL) != 0)
 		exit(1);
 	pthread_mutex_lock(&philo->meal_lock);
 	philo->last_meal_time = philo->table->start_time;
 	pthread_mutex_unlock(&philo->meal_lock);
-	if (start_monitor(philo) != 0)
+	if (!philo->table->meals && start_monitor(philo) != 0)
 		exit(1);
 	if (philo->table->philo_count == 1)
 	{
-		safe_print(philo, "has taken a fork");
+		log_state(philo, ST_FORK);
 		while (1)
 			usleep(100000);
 	}
@@ -50,9 +57,16 @@ void	philosopher_process(t_philo *philo)
 		drop_forks(philo);
 		if (philo->table->must_eat_count > 0
 			&& philo->meals_count >= philo->table->must_eat_count)
+		{
+			if (philo->table->meals)
+				atomic_store_explicit(&philo->table->meals[philo->id - 1]
+					.done, true, memory_order_release);
 			exit(0);
+		}
 		sleep_action(philo);
 		think_action(philo);
+		if (philo->table->meals)
+			tsc_tick();
 	}
 }
 
@@ -129,11 +143,12 @@ void	wait_processes(t_table *table)
 }
 
 /*
-** @brief: Kill all philosopher processes
+** @brief: Kill and reap all philosopher processes
 ** @param: table - pointer to table structure
 ** @return: void
 ** 
-** Used when fork fails or cleanup needed
+** Used when fork fails or cleanup needed. Reaping them means nothing
+** can still write to the shared log ring afterwards.
 */
 void	kill_all_processes(t_table *table)
 {
@@ -146,4 +161,6 @@ void	kill_all_processes(t_table *table)
 			kill(table->philos[i].pid, SIGKILL);
 		i++;
 	}
+	while (waitpid(-1, NULL, 0) > 0)
+		;
 }
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   schedule_bonus.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo_bonus.h"
+
+/*
+** @brief: Advances a philosopher's timeline by one phase
+** @param: philo - pointer to philosopher
+** @param: duration - phase length in milliseconds
+** @return: absolute CLOCK_MONOTONIC deadline of the phase, in ns
+**
+** Implementation:
+**   1. Start the phase at the previous deadline, not at "now"
+**      (from now on the first phase, or after phase_resync())
+**   2. Add the phase length and remember it as the next base
+**
+** Wake-up latency is therefore never carried into the next phase: a
+** late wake-up only shortens the following phase by the same amount.
+*/
+long	next_deadline(t_philo *philo, long duration)
+{
+	if (philo->deadline == 0)
+		philo->deadline = get_mono_ns();
+	philo->deadline += duration * NS_PER_MS;
+	return (philo->deadline);
+}
+
+/*
+** @brief: Restarts the timeline after waiting for forks
+** @param: philo - pointer to philosopher
+** @param: wait_start - get_mono_ns() taken before the wait
+** @return: void
+**
+** A fork wait is real time, not oversleep: eating must last the full
+** time_to_eat from the moment the forks are held. Waits shorter than
+** PHASE_SLACK_NS keep the chain, so an uncontended cycle never drifts.
+*/
+void	phase_resync(t_philo *philo, long wait_start)
+{
+	if (get_mono_ns() - wait_start > PHASE_SLACK_NS)
+		philo->deadline = 0;
+}
+
+/*
+** @brief: Sleeps until an absolute CLOCK_MONOTONIC time, in the kernel
+** @param: deadline - wake-up time in ns (get_mono_ns() base)
+** @return: void
+**
+** clock_nanosleep(TIMER_ABSTIME) wakes at the deadline regardless of
+** how long the call took to enter, and is simply restarted when a
+** signal interrupts it. It still wakes up late by the host's overshoot.
+*/
+void	abs_sleep(long deadline)
+{
+	struct timespec	ts;
+	int				ret;
+
+	ts.tv_sec = deadline / NS_PER_SEC;
+	ts.tv_nsec = deadline % NS_PER_SEC;
+	ret = EINTR;
+	while (ret == EINTR)
+		ret = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+}
+
+/*
+** @brief: Spin-then-sleep wait for an absolute CLOCK_MONOTONIC time
+** @param: deadline - wake-up time in ns (get_mono_ns() base)
+** @return: void
+**
+** Implementation:
+**   1. abs_sleep() until margin_ns before the deadline (bulk sleep)
+**   2. sched_yield() while more than spin_ns remain
+**   3. Busy-wait the last spin_ns
+**
+** margin_ns and spin_ns come from the startup calibration (calib_bonus.c);
+** with --sleep-calib off, or more philosophers than online CPUs, both
+** are 0 and this is a plain abs_sleep().
+*/
+void	sleep_until(long deadline)
+{
+	const t_calib	*c;
+	long			left;
+
+	c = sleep_calib();
+	if (deadline - get_mono_ns() > c->margin_ns)
+		abs_sleep(deadline - c->margin_ns);
+	left = deadline - get_mono_ns();
+	while (left > 0)
+	{
+		if (left > c->spin_ns)
+			sched_yield();
+		left = deadline - get_mono_ns();
+	}
+}
+
+/*
+** @brief: Runs one timed phase (eat, sleep, think) on the timeline
+** @param: philo - pointer to philosopher
+** @param: duration - phase length in milliseconds
+** @return: void
+*/
+void	phase_sleep(t_philo *philo, long duration)
+{
+	sleep_until(next_deadline(philo, duration));
+}
@@ -0,0 +1,136 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shm_log_bonus.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo_bonus.h"
+
+/*
+** @brief: Maps the shared log ring and allocates the output buffer
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+**
+** Must run before create_processes(): the children inherit the
+** MAP_SHARED mapping, so every push lands in the parent's view of it.
+** Slot i starts with seq = i, i.e. free for position i.
+*/
+int	open_log(t_table *table)
+{
+	void	*map;
+	int		i;
+
+	map = mmap(NULL, sizeof(t_shring), PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (map == MAP_FAILED)
+		return (printf("Error: Failed to map log ring\n"), 1);
+	table->log.ring = map;
+	table->log.buf = malloc(LOG_BATCH_SIZE);
+	table->log.batch = malloc(sizeof(t_event) * SHRING_SIZE);
+	if (!table->log.buf || !table->log.batch)
+		return (printf("Error: Failed to allocate log buffer\n"), 1);
+	atomic_init(&table->log.ring->tail, 0);
+	table->log.held = 0;
+	table->log.limit = -1;
+	i = 0;
+	while (i < SHRING_SIZE)
+	{
+		atomic_init(&table->log.ring->slots[i].seq, i);
+		i++;
+	}
+	return (0);
+}
+
+/*
+** @brief: Publishes one event into the shared ring (child side)
+** @param: ring - shared ring
+** @param: start - simulation start time (ns), id/state - event payload
+** @return: void
+**
+** Implementation:
+**   1. Reserve a position with one atomic fetch_add on tail
+**   2. Wait until the parent has freed that slot (ring a full lap ahead)
+**   3. Stamp and fill the slot, then publish it with seq = position + 1
+**
+** The clock is read after the reservation, so position order and time
+** order agree except when a child is preempted in between, or between
+** stamping and publishing. Its slot stays unpublished meanwhile, so the
+** parent stops there and holds back what it took but is newer than the
+** reservation (see log_drain()).
+*/
+void	log_push(t_shring *ring, long start, int id, t_state state)
+{
+	unsigned long	pos;
+	t_slot			*slot;
+
+	pos = atomic_fetch_add_explicit(&ring->tail, 1, memory_order_relaxed);
+	slot = &ring->slots[pos & (SHRING_SIZE - 1)];
+	while (atomic_load_explicit(&slot->seq, memory_order_acquire) != pos)
+		usleep(50);
+	slot->ev.ts = elapsed_ms(start);
+	slot->ev.id = id;
+	slot->ev.state = state;
+	atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+}
+
+/*
+** @brief: Starts the parent's log drain thread
+** @param: table - pointer to table structure
+** @return: 0 on success, 1 on error
+**
+** Started before create_processes(): children push as soon as they
+** are forked, and with nobody draining, the first ones would fill the
+** ring and starve while the parent is still forking the rest. The
+** children only get a copy of the forking thread and never touch the
+** parent-side logger.
+*/
+int	start_logger(t_table *table)
+{
+	atomic_init(&table->log.stop, false);
+	if (pthread_create(&table->log.thread, NULL, logger_routine, table) != 0)
+	{
+		printf("Error: Failed to create log thread\n");
+		return (1);
+	}
+	table->log.running = true;
+	return (0);
+}
+
+/*
+** @brief: Stops the log thread after its final drain
+** @param: table - pointer to table structure
+** @return: void
+**
+** Called once every child has been reaped, so nothing can be pushed
+** any more and slots reserved by killed children can be skipped.
+*/
+void	stop_logger(t_table *table)
+{
+	if (!table->log.running)
+		return ;
+	atomic_store(&table->log.stop, true);
+	pthread_join(table->log.thread, NULL);
+	table->log.running = false;
+}
+
+/*
+** @brief: Unmaps the ring and frees the output buffer
+** @param: table - pointer to table structure
+** @return: void
+*/
+void	close_log(t_table *table)
+{
+	if (table->log.ring)
+		munmap(table->log.ring, sizeof(t_shring));
+	table->log.ring = NULL;
+	free(table->log.buf);
+	table->log.buf = NULL;
+	free(table->log.batch);
+	table->log.batch = NULL;
+}
@@ -13,48 +13,54 @@
 #include "../include/philo_bonus.h"
 
 /*
-** @brief: Thread-safe output function using semaphore
-** @param: philo - philosopher performing action, msg - message to print
+** @brief: Announce philosopher death
+** @param: philo - philosopher who died
 ** @return: void
 ** 
 ** Implementation:
-**   1. Wait on write semaphore for exclusive access
-**   2. Get current timestamp
-**   3. Print formatted message
-**   4. Post write semaphore
+**   1. Push the death event into the shared log ring
+**   2. Post dead semaphore to signal main process
 ** 
-** No simulation_end check needed - processes exit on death
+** After posting dead_sem, main process will kill all others. The
+** parent's log thread prints the death and drops everything after it,
+** so a second child dying in the same instant is never reported.
+*/
+void	announce_death(t_philo *philo)
+{
+	log_push(philo->table->log.ring, philo->table->start_time, philo->id,
+		ST_DIED);
+	sem_post(philo->table->dead_sem);
+}
+
+/*
+** @brief: Returns the output text of a state
+** @param: state - state code
+** @return: message without timestamp or id
 */
-void	safe_print(t_philo *philo, char *msg)
+const char	*state_msg(t_state state)
 {
-	long	timestamp;
+	static const char	*msgs[] = {
+		"has taken a fork",
+		"is eating",
+		"is sleeping",
+		"is thinking",
+		"died"
+	};
 
-	sem_wait(philo->table->write_sem);
-	timestamp = elapsed_time(philo->table->start_time);
-	printf("%ld %d %s\n", timestamp, philo->id, msg);
-	sem_post(philo->table->write_sem);
+	return (msgs[state]);
 }
 
 /*
-** @brief: Announce philosopher death
-** @param: philo - philosopher who died
+** @brief: Logs a philosopher state change
+** @param: philo - philosopher changing state, state - new state
 ** @return: void
-** 
-** Implementation:
-**   1. Wait on write semaphore
-**   2. Print death message
-**   3. Post write semaphore
-**   4. Post dead semaphore to signal main process
-** 
-** After posting dead_sem, main process will kill all others
+**
+** The event goes into the shared ring; the parent turns it into text
+** or a --trace-bin record. No semaphore and no syscall on this path
+** unless the ring is full.
 */
-void	announce_death(t_philo *philo)
+void	log_state(t_philo *philo, t_state state)
 {
-	long	timestamp;
-
-	sem_wait(philo->table->write_sem);
-	timestamp = elapsed_time(philo->table->start_time);
-	printf("%ld %d died\n", timestamp, philo->id);
-	sem_post(philo->table->write_sem);
-	sem_post(philo->table->dead_sem);
+	log_push(philo->table->log.ring, philo->table->start_time, philo->id,
+		state);
 }
@@ -0,0 +1,125 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_bonus.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: mhaddadi <mhaddadi@student.42porto.com>    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/16 00:00:00 by mhaddadi          #+#    #+#             */
+/*   Updated: 2026/10/16 00:00:00 by mhaddadi         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../include/philo_bonus.h"
+
+/*
+** @brief: Opens the --trace-bin file and writes its header
+** @param: table - pointer to table structure
+** @return: 0 on success (or tracing disabled), 1 on error
+**
+** Only the parent's log thread writes to the file; the children just
+** push events into the shared ring.
+*/
+int	open_trace(t_table *table)
+{
+	unsigned char	hdr[TRACE_HEADER_SIZE];
+
+	if (!table->opts.trace_path)
+		return (0);
+	if (table->philo_count > TRACE_MAX_ID)
+		return (printf("Error: --trace-bin supports at most %d philosophers\n",
+				TRACE_MAX_ID), 1);
+	table->trace.fd = open(table->opts.trace_path,
+			O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (table->trace.fd < 0)
+		return (printf("Error: Cannot open %s\n", table->opts.trace_path), 1);
+	table->trace.id_bytes = 1 + (table->philo_count > TRACE_SHORT_ID);
+	memcpy(hdr, TRACE_MAGIC, 4);
+	memset(hdr + 4, 0, 4);
+	hdr[4] = TRACE_VERSION;
+	hdr[5] = table->trace.id_bytes;
+	if (write(table->trace.fd, hdr, TRACE_HEADER_SIZE) != TRACE_HEADER_SIZE)
+	{
+		close(table->trace.fd);
+		table->trace.fd = -1;
+		return (printf("Error: Failed to set up %s\n",
+				table->opts.trace_path), 1);
+	}
+	table->trace.last_ts = 0;
+	return (0);
+}
+
+/*
+** @brief: Appends a little endian value of len bytes
+** @param: dst - destination, value - value, len - byte count
+** @return: len
+*/
+static size_t	put_le(unsigned char *dst, long value, size_t len)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < len)
+	{
+		dst[i] = (value >> (8 * i)) & 0xff;
+		i++;
+	}
+	return (len);
+}
+
+/*
+** @brief: Encodes one event as a variable-width record
+** @param: rec - destination (at least 7 bytes), delta - ms since the
+**         previous record, id_bytes - id width, ev - event
+** @return: record length in bytes
+*/
+static size_t	encode_record(unsigned char *rec, long delta, int id_bytes,
+		const t_event *ev)
+{
+	size_t	len;
+
+	len = 1 + put_le(rec + 1, ev->id, id_bytes);
+	if (delta < TRACE_DELTA_ESC)
+		rec[0] = (delta << 3) | ev->state;
+	else if (delta <= 0xffff)
+	{
+		rec[0] = (TRACE_DELTA_ESC << 3) | ev->state;
+		len += put_le(rec + len, delta, 2);
+	}
+	else
+	{
+		rec[0] = (TRACE_DELTA_LONG << 3) | ev->state;
+		len += put_le(rec + len, delta, 4);
+	}
+	return (len);
+}
+
+/*
+** @brief: Encodes one event relative to the previous record
+** @param: trace - trace writer, dst - destination (at least 7 bytes)
+** @param: ev - event to record
+** @return: record length in bytes
+*/
+size_t	trace_record(t_trace *trace, unsigned char *dst, const t_event *ev)
+{
+	long	delta;
+
+	delta = ev->ts - trace->last_ts;
+	if (delta < 0)
+		delta = 0;
+	trace->last_ts += delta;
+	return (encode_record(dst, delta, trace->id_bytes, ev));
+}
+
+/*
+** @brief: Closes the trace file
+** @param: table - pointer to table structure
+** @return: void
+*/
+void	close_trace(t_table *table)
+{
+	if (!table->opts.trace_path || table->trace.fd <= 0)
+		return ;
+	close(table->trace.fd);
+	table->trace.fd = -1;
+}